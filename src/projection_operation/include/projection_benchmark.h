@@ -0,0 +1,181 @@
+// ########################################################################################################
+
+// ======================================== projection_benchmark.h ========================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_BENCHMARK_H
+#define _PROJECTION_BENCHMARK_H
+
+// ================================================== INCLUDE ==================================================
+
+// Local custom libraries
+#include "projection_utils.h"
+#include "projection_renderer.h"
+
+// Standard Library for timing and allocation counting
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <new>
+
+// ================================================== VARIABLES ==================================================
+
+// Directory paths
+std::string bench_cfg_path = CONFIG_DIR_PATH + "/cfg_m1_c0.xml";
+std::string bench_wall_img_path = IMAGE_TOP_DIR_PATH + "/calibration_images/1_test_pattern.bmp";
+std::string bench_mask_img_path = IMAGE_TOP_DIR_PATH + "/ui_state_images/m0.bmp";
+
+// Upper bound on the operations of one benchmark run
+const long long BENCH_MAX_OPS = 1000000000LL;
+
+// Frame time at the 60 Hz projector refresh rate, used to report the frame scaling benchmarks
+const double BENCH_FRAME_BUDGET_NS = 1.0e9 / 60.0;
+
+// Command line options (set with "--<option>=<value>")
+int benchMazeSize = MAZE_SIZE;       // Grid size used by the geometry benchmarks ("--maze_size")
+double benchMinTimeS = 0.5;          // Minimum run time of each benchmark ("--min_time")
+std::string benchFilterStr;          // Only run benchmarks whose name contains this string ("--filter")
+std::string benchTmpDirPath = ".";   // Directory for files written by the benchmarks ("--tmp_dir")
+int benchScalingMax = 15;            // Largest maze size of the scaling benchmarks ("--scaling_max")
+
+// Number of operator new calls made by the process, see the replacements in projection_benchmark.cpp
+std::atomic<long long> nBenchAllocs(0);
+
+// Sink for benchmark results so the compiler cannot remove the measured calls
+volatile float benchSink = 0.0f;
+
+/**
+ * @brief Struct describing one benchmark.
+ *
+ * The run function performs the requested number of operations and returns 0 on success or -1 on
+ * failure. The item and byte counts describe the work done by one operation and are used to
+ * report throughput; 0 disables the corresponding column.
+ */
+struct BenchmarkCase
+{
+    std::string name;                       // Name shown in the report
+    std::function<int(long long)> run_fn;   // Runs the given number of operations
+    double items_per_op = 0.0;              // Items (e.g. walls) processed per operation
+    double bytes_per_op = 0.0;              // Bytes processed per operation
+};
+
+/**
+ * @brief Struct holding the measurements of one benchmark.
+ */
+struct BenchmarkResult
+{
+    long long n_ops = 0;          // Number of operations timed
+    double ns_per_op = 0.0;       // Wall time per operation
+    double allocs_per_op = 0.0;   // operator new calls per operation
+    double items_per_s = 0.0;     // Item throughput
+    double bytes_per_s = 0.0;     // Byte throughput
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Parses the "--<option>=<value>" command line options into the bench* variables.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ *
+ * @return 0 on successful execution, -1 on an unknown or invalid option.
+ */
+int parseBenchmarkArgs(int, char **);
+
+/**
+ * @brief Runs a benchmark until it has taken at least benchMinTimeS.
+ *
+ * The number of operations starts at 1 and grows between runs until the minimum time is reached,
+ * Google Benchmark style, and only the final run is reported. Allocations are counted over that run.
+ *
+ * @param bench_case Benchmark to run.
+ * @param[out] r_result Reference to the measurements of the final run.
+ *
+ * @return 0 on successful execution, -1 if the benchmark failed.
+ */
+int runBenchmark(const BenchmarkCase &, BenchmarkResult &);
+
+/**
+ * @brief Prints one row of the benchmark report.
+ *
+ * @param bench_case Benchmark that was run.
+ * @param result Measurements of the benchmark.
+ */
+void printBenchmarkResult(const BenchmarkCase &, const BenchmarkResult &);
+
+/**
+ * @brief Loads an image with loadImgTextures(), as the calibration node does.
+ *
+ * @param img_path Path of the image file.
+ * @param[out] r_img_id Reference to the DevIL image ID.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int loadBenchImage(std::string, ILuint &);
+
+/**
+ * @brief Fills a base and an overlay buffer with seeded pseudo-random pixels.
+ *
+ * About 60% of the overlay pixels are set to the white key color so the color key benchmarks see
+ * a mix of kept and replaced pixels.
+ *
+ * @param[out] r_base_vec Reference to the base image buffer.
+ * @param[out] r_overlay_vec Reference to the overlay image buffer.
+ * @param n_pxl Number of pixels.
+ * @param format Pixel format of both buffers.
+ */
+void fillCompositeBuffers(std::vector<uint8_t> &, std::vector<uint8_t> &, size_t, PixelFormat);
+
+/**
+ * @brief Builds the list of benchmarks covering the per-frame functions of projection_utils and the
+ * compositing kernels.
+ *
+ * @param wall_img_id DevIL image used as the baseline for mergeImages().
+ * @param mask_img_id DevIL image used as the mask for mergeImages().
+ *
+ * @return std::vector<BenchmarkCase> The benchmarks in report order.
+ */
+std::vector<BenchmarkCase> createBenchmarkCases(ILuint, ILuint);
+
+/**
+ * @brief Creates an EGL headless context with the renderer, a projector sized FBO and a wall texture
+ * array for the frame scaling benchmarks.
+ *
+ * @param[out] r_context Reference to the headless context, left current.
+ * @param[out] r_renderer Reference to the renderer.
+ * @param[out] r_fbo_id Reference to the FBO ID.
+ * @param[out] r_fbo_texture_id Reference to the FBO color texture ID.
+ * @param[out] r_texture_array_id Reference to the wall texture array ID.
+ * @param wall_img_id DevIL image uploaded as the only wall texture array layer.
+ *
+ * @return 0 on successful execution, -1 on failure or when not built with HEADLESS_EGL.
+ */
+int setupBenchFrameContext(HeadlessContextEGL &, RendererGL &, GLuint &, GLuint &, GLuint &, ILuint);
+
+/**
+ * @brief Deletes the objects and the context created by setupBenchFrameContext().
+ */
+void deleteBenchFrameContext(HeadlessContextEGL &, RendererGL &, GLuint &, GLuint &, GLuint &);
+
+/**
+ * @brief Runs the maze size scaling benchmarks.
+ *
+ * Maze sizes run from MAZE_SIZE to benchScalingMax in steps of 2 (odd sizes keep a center chamber),
+ * plus benchScalingMax itself. Two tables are printed:
+ * - "wallGeometry/<size>": the geometry rebake done when a projector's calibration changes, i.e.
+ *   the homography, parameter field and wall vertices of every calibration mode. It does not run
+ *   per frame, so it is reported in microseconds only.
+ * - "wallFrame/<size>": one projector frame with the default control points, rendered headless
+ *   into an FBO at projector resolution with the display node's instanced wall draw and waiting
+ *   for the GPU with glFinish(), against the 60 Hz frame budget. Needs a HEADLESS_EGL build and is skipped otherwise.
+ *
+ * @param wall_img_id DevIL image used as the wall texture of the frame benchmarks.
+ *
+ * @return 0 on successful execution, -1 if a benchmark failed.
+ */
+int runScalingBenchmarks(ILuint);
+
+#endif
@@ -0,0 +1,154 @@
+// ########################################################################################################
+
+// ========================================= projection_bundle.h =========================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_BUNDLE_H
+#define _PROJECTION_BUNDLE_H
+
+// ================================================== INCLUDE ==================================================
+
+// ROS for logging
+#include <ros/console.h>
+
+// Standard Library for various utilities
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ================================================== VARIABLES ==================================================
+
+/**
+ * @brief Binary calibration bundle holding the calibration of every monitor and calibration mode.
+ *
+ * @details
+ * File layout, little-endian, every field 4 bytes so the entries can be read in place from a
+ * memory mapping without parsing:
+ * - CalibrationBundleHeader
+ * - n_entries x CalibrationBundleEntry, sorted by monitor then calibration mode
+ *
+ * The header holds a CRC-32 of the entry bytes, checked when the bundle is opened.
+ */
+
+// File identifier at the start of every bundle
+const char CAL_BUNDLE_MAGIC[8] = {'P', 'R', 'O', 'J', 'C', 'A', 'L', '\0'};
+
+// Format version, incremented on any layout change
+const uint32_t CAL_BUNDLE_VERSION = 1;
+
+// Written as 0x01020304, reads differently on a host with the other byte order
+const uint32_t CAL_BUNDLE_ENDIAN_TAG = 0x01020304;
+
+/**
+ * @brief Header at the start of a calibration bundle.
+ */
+struct CalibrationBundleHeader
+{
+    char magic[8];         // CAL_BUNDLE_MAGIC
+    uint32_t version;      // CAL_BUNDLE_VERSION
+    uint32_t endian_tag;   // CAL_BUNDLE_ENDIAN_TAG
+    uint32_t entry_size;   // sizeof(CalibrationBundleEntry)
+    uint32_t n_entries;    // Number of entries following the header
+    uint32_t entries_crc;  // CRC-32 of the entry bytes
+    uint32_t reserved;     // Zero
+};
+
+/**
+ * @brief Calibration of one monitor and calibration mode.
+ */
+struct CalibrationBundleEntry
+{
+    int32_t mon_ind;                 // Monitor index
+    int32_t cal_ind;                 // Calibration mode index
+    float ctrl_point_params[4][6];   // Control point parameters (x, y, width, height, shear x, shear y)
+    float hom[9];                    // Homography matrix, row-major
+};
+
+static_assert(sizeof(CalibrationBundleHeader) == 32, "CalibrationBundleHeader must have no padding");
+static_assert(sizeof(CalibrationBundleEntry) == 140, "CalibrationBundleEntry must have no padding");
+
+/**
+ * @brief Read-only memory mapping of a calibration bundle.
+ *
+ * p_entries points straight into the mapping. Close with closeCalibrationBundle().
+ */
+struct MappedCalibrationBundle
+{
+    const CalibrationBundleHeader *p_header = nullptr; // Header at the start of the mapping
+    const CalibrationBundleEntry *p_entries = nullptr; // First entry
+    size_t n_entries = 0;                              // Number of entries
+    size_t file_size = 0;                              // Size of the mapping
+    void *p_map = nullptr;                             // Start of the mapping
+    void *p_file_handle = nullptr;                     // Platform file and mapping handles
+    void *p_map_handle = nullptr;
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3, as used by zlib) of a buffer.
+ *
+ * @param p_data Pointer to the data.
+ * @param n_bytes Number of bytes.
+ *
+ * @return CRC-32 of the data.
+ */
+uint32_t computeCRC32(const void *, size_t);
+
+/**
+ * @brief Memory-maps a calibration bundle and validates its header and checksum.
+ *
+ * @param bundle_path Path of the bundle file.
+ * @param[out] r_bundle Reference to the mapping, left closed on failure.
+ *
+ * @return 0 on successful execution, -1 if the file cannot be mapped or is not a valid bundle.
+ */
+int openCalibrationBundle(const std::string &, MappedCalibrationBundle &);
+
+/**
+ * @brief Unmaps a calibration bundle. Safe to call on a closed bundle.
+ *
+ * @param[out] r_bundle Reference to the mapping to close.
+ */
+void closeCalibrationBundle(MappedCalibrationBundle &);
+
+/**
+ * @brief Finds the entry of a monitor and calibration mode.
+ *
+ * @param bundle Open calibration bundle.
+ * @param mon_ind Monitor index.
+ * @param cal_ind Calibration mode index.
+ *
+ * @return Pointer to the entry inside the mapping, nullptr if the bundle has none.
+ */
+const CalibrationBundleEntry *findCalibrationBundleEntry(const MappedCalibrationBundle &, int, int);
+
+/**
+ * @brief Renames a file over another one in a single step.
+ *
+ * Readers of the destination see either the old or the new file, never a partial one. Uses
+ * MoveFileEx() on Windows, where rename() fails if the destination exists.
+ *
+ * @param src_path Path of the file to rename, usually a fully written temporary file.
+ * @param dst_path Path the file is renamed to, replaced if it exists.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int replaceFile(const std::string &, const std::string &);
+
+/**
+ * @brief Writes a calibration bundle.
+ *
+ * The entries are sorted by monitor then calibration mode and written to "<bundle_path>.tmp",
+ * which is then renamed over the bundle so readers never see a partial file.
+ *
+ * @param bundle_path Path of the bundle file.
+ * @param entry_vec Entries to write, at most one per monitor and calibration mode.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int writeCalibrationBundle(const std::string &, std::vector<CalibrationBundleEntry>);
+
+#endif
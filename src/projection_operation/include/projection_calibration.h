@@ -11,6 +11,17 @@
 
 // Local custom libraries
 #include "projection_utils.h"
+#include "projection_renderer.h"
+#include "projection_metrics.h"
+
+// Standard Library for the background save writer
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+
+// ROS message for live calibration streaming
+#include <std_msgs/Float32MultiArray.h>
 
 // ================================================== VARIABLES ==================================================
 
@@ -29,6 +40,12 @@ std::string calModeStr = "position"; // Parmeter being modified [position, dimen
 // The 3x3 homography matrix of 32-bit floating-point numbers used to warp perspective.
 cv::Mat homMat = cv::Mat::eye(3, 3, CV_32F);
 
+// Number of rows and columns in the maze (set with the "~maze_size" parameter)
+int mazeSize = MAZE_SIZE;
+
+// Wall parameters of every grid cell, interpolated from ctrlPointParams whenever it changes
+WallParamField wallParamField;
+
 // Directory paths
 std::string image_wall_dir_path = IMAGE_TOP_DIR_PATH + "/calibration_images";
 std::string image_state_dir_path = IMAGE_TOP_DIR_PATH + "/ui_state_images";
@@ -85,6 +102,54 @@ size_t nCalModes = imgCalPathVec.size(); // Number of calibration modes
 // Variables related to window and OpenGL
 GLFWwindow *p_windowID = nullptr;
 GLFWmonitor **pp_monitorIDVec = nullptr;
+RendererGL renderer; // Renderer shader program and streaming buffers
+GLuint texCalArrayID = 0; // Texture array of the wall images followed by the monitor, parameter and calibration images
+bool isFrameDirty = true; // Flag to indicate the frame must be redrawn (set by key and window events)
+
+// Frame timing instrumentation (enabled by the "~frame_metrics" ROS parameter)
+FrameMetrics frameMetrics; // Calibration, geometry, draw and swap timing, one sample per redraw
+FrameMetrics loopMetrics;  // Event polling timing, one sample per main loop pass
+
+// Calibration changes requested by the key callback and applied by the main loop, see applyCalActions()
+enum CalActionFlag
+{
+    CAL_ACTION_NONE = 0,         // Nothing to apply
+    CAL_ACTION_LOAD = 1 << 0,    // Load the control points of the active monitor and mode [L]
+    CAL_ACTION_UPDATE = 1 << 1,  // Control points changed, homography and wall parameters must be recomputed
+    CAL_ACTION_PUBLISH = 1 << 2, // Stream the control points to the display node
+    CAL_ACTION_SAVE = 1 << 3,    // Queue the control points for the background writer [ENTER]
+};
+int calActionFlags = CAL_ACTION_NONE;
+
+// Maximum time to block waiting for window events while the frame is clean
+const double EVENT_WAIT_TIMEOUT_S = 0.05;
+
+// Live calibration streaming variables (the display node applies the stream to its geometry, see CAL_LIVE_TOPIC)
+bool isCalLive = false;     // Flag to publish the calibration (set from the "~live_calibration" ROS parameter)
+ros::Publisher calLivePub; // Publisher of the live calibration
+
+/**
+ * @brief Struct for one calibration save handed to the background writer.
+ */
+struct CalibrationSave
+{
+    int mon_ind = 0;                                        // Monitor index
+    int cal_ind = 0;                                        // Calibration mode index
+    std::array<std::array<float, 6>, 4> ctrl_point_params; // Control point parameters at the time of the save
+    cv::Mat hom_mat;                                        // Homography matrix, a copy owned by the save
+    int n_coalesced = 0;                                    // Number of later saves of the same file merged into this one
+    int xml_status = 0;                                     // XML file result set by the writer, 0 on success or -1 on failure
+    int bundle_status = 0;                                  // Bundle rebuild result of the save's batch, 0 on success or -1 on failure
+};
+
+// Background save writer variables (the main thread queues saves, the writer does the disk I/O)
+std::thread saveThread;                      // Writer thread
+std::mutex saveMutex;                        // Guards the save queues and the quit flag
+std::condition_variable saveCond;            // Signals queued saves and the quit flag to the writer
+std::vector<CalibrationSave> saveQueueVec;   // Saves waiting for the writer, at most one per file
+std::vector<CalibrationSave> saveWritingVec; // Saves the writer is currently writing
+std::vector<CalibrationSave> saveDoneVec;    // Saves finished by the writer, reported by the main thread
+bool isSaveQuit = false;                     // Flag to stop the writer once the queue is empty
 
 // ================================================== FUNCTIONS ==================================================
 
@@ -117,6 +182,16 @@ void callbackKeyBinding(GLFWwindow *, int, int, int, int);
  */
 void callbackFrameBufferSizeGLFW(GLFWwindow *, int, int);
 
+/**
+ * @brief Callback function for handling window refresh requests.
+ *
+ * Called when the window contents are damaged (e.g. uncovered or restored),
+ * and marks the frame dirty so it is redrawn.
+ *
+ * @param window Pointer to the GLFW window.
+ */
+void callbackWindowRefreshGLFW(GLFWwindow *);
+
 /**
  * @brief Callback function for handling errors.
  *
@@ -132,6 +207,9 @@ static void callbackErrorGLFW(int, const char *);
  * @brief Checks for OpenGL errors and logs them.
  * Should be called after OpenGL API calls.
  *
+ * @note glGetError() stalls the pipeline, so the check only runs when isGLSyncCheck is set.
+ *       Otherwise errors are reported asynchronously by the debug output callback.
+ *
  * @example checkErrorGL(__LINE__, __FILE__);
  *
  * @param line Line number where the function is called.
@@ -186,6 +264,7 @@ int updateWindowMonMode(GLFWwindow *, int, GLFWmonitor **&, int, bool);
  * This function uses OpenGL to draw a quadrilateral that represents a control point.
  * The control point is drawn as a colored circle.
  *
+ * @param r_renderer Reference to the renderer of the current context.
  * @param x The control point x-coordinate.
  * @param y The control point y-coordinate.
  * @param radius The radius of the control point.
@@ -193,16 +272,20 @@ int updateWindowMonMode(GLFWwindow *, int, GLFWmonitor **&, int, bool);
  *
  * @return 0 if no errors, -1 if error.
  */
-int drawControlPoint(float, float, float, std::vector<float>);
+int drawControlPoint(RendererGL &, float, float, float, std::vector<float>);
 
 /**
  * @brief Draws a textured rectangle using OpenGL.
  *
- * @param quad_vertices_vec Vector of vertex/corner points for a rectangular image.
+ * @param r_renderer Reference to the renderer of the current context.
+ * @param p_quad_xy Pointer to the x, y of the 4 corners of the rectangle, in the order of computeQuadVertices().
+ * @param texture_array_id Texture array holding the images to map onto the rectangle.
+ * @param base_layer Layer of the image to map onto the rectangle.
+ * @param overlay_layer_arr Layers of the state images composited over it, negative entries are skipped.
  *
  * @return 0 if no errors, -1 if error.
  */
-int drawQuadImage(std::vector<cv::Point2f>);
+int drawQuadImage(RendererGL &, const float *, GLuint, GLint, const std::array<GLint, N_OVERLAY_LAYERS> &);
 
 /**
  * @brief Renders a 2D maze grid by drawing each cell (e.g., wall) with texture mapping and perspective warping.
@@ -212,7 +295,9 @@ int drawQuadImage(std::vector<cv::Point2f>);
  * 1. Texture mapping of the wall images.
  * 2. Perspective warping based on a precomputed homography matrix.
  * 3. Shear and height adjustments based on control point calibration.
- * 4. Optional overlay of status images for cells corresponding to selected control points.
+ * 4. Display of the status overlay image on the cell corresponding to the selected control point.
+ *
+ * The warped corners of all walls are computed in one computeWallVertices() call before drawing.
  * 
  * @section Control Point and Grid Correspondence
  * 
@@ -225,17 +310,93 @@ int drawQuadImage(std::vector<cv::Point2f>);
  * - Bottom-Right:  NDC (1, -1),    Control Point [2],  Grid Index [s-1][0]
  * - Bottom-Left:   NDC (-1, -1),   Control Point [3],  Grid Index [0][0]
  * 
+ * @param r_renderer Reference to the renderer of the current context.
  * @param hom_mat The 3x3 homography matrix used for perspective warping of the walls.
- * @param ctrl_point_params A 4x6 array containing control point parameters (x, y, width, height, shear x, shear y).
- * @param fbo_texture_id OpenGL framebuffer object's texture ID.
- * @param img_wall_id DevIL image ID for the base wall image.
- * @param img_mode_mon_id DevIL image ID for the monitor mode image.
- * @param img_mode_param_id DevIL image ID for the parameter visualization image.
- * @param img_mode_cal_id DevIL image ID for the calibration image.
+ * @param param_field Wall parameters of every grid cell, see computeWallParamField().
+ * @param texture_array_id Texture array holding the wall and state images.
+ * @param wall_layer Layer of the wall image.
+ * @param overlay_layer_arr Layers of the monitor, parameter and calibration state images shown on the selected wall.
  *
  * @return Integer status code: 0 if successful, -1 if an error occurred.
  */
-int drawWalls(cv::Mat, std::array<std::array<float, 6>, 4>, GLuint, ILuint, ILuint, ILuint, ILuint);
+int drawWalls(RendererGL &, const cv::Mat &, const WallParamField &, GLuint, GLint, const std::array<GLint, N_OVERLAY_LAYERS> &);
+
+/**
+ * @brief Publishes the calibration of the active monitor and calibration mode on CAL_LIVE_TOPIC.
+ *
+ * Called after the keys that edit the control points (position, dimension and shear nudges),
+ * after resetting them with R and after loading them. Calibration mode switches only reset the
+ * control points of the newly selected mode and are not published, so browsing modes does not
+ * replace the saved calibration the display node shows with the defaults.
+ */
+void publishLiveCalibration();
+
+/**
+ * @brief Applies the calibration changes flagged in calActionFlags by the key callback.
+ *
+ * Loads, recomputes, publishes and then queues the control points for saving, in that order.
+ * Called by the main loop after polling events, so the calibration and geometry stage timers
+ * never run nested inside the event stage.
+ */
+void applyCalActions();
+
+/**
+ * @brief Queues the calibration of a monitor and calibration mode for the background writer.
+ *
+ * Never touches the disk. A save of a file that is still queued replaces the queued one, so
+ * rapid repeated saves coalesce into a single write.
+ *
+ * @param mon_id_ind Index of the monitor.
+ * @param mode_cal_ind Index of the calibration mode.
+ * @param ctrl_point_params Control point parameters to save.
+ * @param hom_mat Homography matrix to save, copied.
+ */
+void queueCalibrationSave(int, int, const std::array<std::array<float, 6>, 4> &, const cv::Mat &);
+
+/**
+ * @brief Gets the newest calibration queued or being written for a monitor and calibration mode.
+ *
+ * Used on load so a file is not read back before the writer has replaced it.
+ *
+ * @param mon_id_ind Index of the monitor.
+ * @param mode_cal_ind Index of the calibration mode.
+ * @param[out] r_ctrl_point_params Reference to the control point parameters.
+ * @param[out] r_hom_mat Reference to the homography matrix.
+ *
+ * @return True if a save of that file is pending.
+ */
+bool getPendingCalibrationSave(int, int, std::array<std::array<float, 6>, 4> &, cv::Mat &);
+
+/**
+ * @brief Background writer loop.
+ *
+ * Takes every queued save at once, writes each XML file through saveCoordinatesXML(), rebuilds
+ * the calibration bundle once for the batch and hands the results back to the main thread,
+ * waking it with glfwPostEmptyEvent(). Drains the queue before exiting on isSaveQuit.
+ */
+void saveWriterLoop();
+
+/**
+ * @brief Starts the background writer.
+ *
+ * @return 0 on successful execution, -1 if the thread could not be started.
+ */
+int startSaveWriter();
+
+/**
+ * @brief Stops the background writer after it has written every queued save.
+ */
+void stopSaveWriter();
+
+/**
+ * @brief Reports the saves finished by the background writer. Called by the main loop.
+ *
+ * Logs the XML file and the bundle rebuild results separately, a failed bundle rebuild leaves the
+ * saved XML file valid and the display node loads it instead of the bundle.
+ *
+ * @return Number of saves reported.
+ */
+int reportCalibrationSaves();
 
 /**
  * @brief  Entry point for the projection_calibration ROS node.
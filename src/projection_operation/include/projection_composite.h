@@ -0,0 +1,142 @@
+// ########################################################################################################
+
+// ======================================== projection_composite.h ========================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_COMPOSITE_H
+#define _PROJECTION_COMPOSITE_H
+
+// ================================================== INCLUDE ==================================================
+
+// ROS for logging
+#include <ros/console.h>
+
+// Standard Library for various utilities
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ================================================== VARIABLES ==================================================
+
+/**
+ * @brief Interleaved 8-bit pixel formats supported by the compositing kernels.
+ */
+enum PixelFormat
+{
+    PIXEL_RGB = 0, // 3 bytes per pixel, red first
+    PIXEL_BGR,     // 3 bytes per pixel, blue first
+    PIXEL_RGBA,    // 4 bytes per pixel, red first, alpha last
+};
+
+/**
+ * @brief How the overlay image is combined with the base image.
+ */
+enum CompositeMode
+{
+    COMPOSITE_COLOR_KEY = 0, // Overlay pixels replace the base unless their color equals the key color
+    COMPOSITE_ALPHA,         // Overlay is blended over the base by its alpha channel (PIXEL_RGBA only)
+};
+
+/**
+ * @brief Instruction set used by the compositing kernels.
+ */
+enum CompositeKernel
+{
+    KERNEL_SCALAR = 0, // Portable reference implementation
+    KERNEL_SSE2,       // 16 bytes per instruction, x86 only
+    KERNEL_AVX2,       // 32 bytes per instruction, x86 only and detected at runtime
+    N_COMPOSITE_KERNELS,
+};
+
+// Default key color treated as transparent (white)
+const std::array<uint8_t, 3> COMPOSITE_KEY_WHITE = {{255, 255, 255}};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Gets the number of bytes per pixel of a pixel format.
+ *
+ * @param format Pixel format.
+ *
+ * @return Bytes per pixel.
+ */
+int getPixelSize(PixelFormat);
+
+/**
+ * @brief Gets the display name of a compositing kernel.
+ *
+ * @param kernel Compositing kernel.
+ *
+ * @return Kernel name.
+ */
+const char *getCompositeKernelName(CompositeKernel);
+
+/**
+ * @brief Checks whether the CPU running the process supports a compositing kernel.
+ *
+ * @param kernel Compositing kernel.
+ *
+ * @return True if the kernel can be used.
+ */
+bool isCompositeKernelSupported(CompositeKernel);
+
+/**
+ * @brief Gets the kernel used by compositeImages().
+ *
+ * Defaults to the widest kernel the CPU supports, detected on first use.
+ *
+ * @return Active compositing kernel.
+ */
+CompositeKernel getCompositeKernel();
+
+/**
+ * @brief Overrides the kernel used by compositeImages(), e.g. to compare against KERNEL_SCALAR.
+ *
+ * @param kernel Compositing kernel.
+ *
+ * @return 0 on successful execution, -1 if the CPU does not support the kernel.
+ */
+int setCompositeKernel(CompositeKernel);
+
+/**
+ * @brief Composites an overlay image onto a base image.
+ *
+ * All kernels produce identical output. In COMPOSITE_ALPHA mode each color channel is
+ * round((overlay * a + base * (255 - a)) / 255) and the alpha channel is combined the same way
+ * with an overlay alpha of 255, i.e. the standard "over" operator.
+ *
+ * @param p_base Pointer to the base image pixels.
+ * @param p_overlay Pointer to the overlay image pixels.
+ * @param[out] p_out Pointer to the output pixels, which may be the same buffer as either input
+ *                   (the same pointer, not a partial overlap).
+ * @param n_pxl Number of pixels in each image.
+ * @param format Pixel format shared by the three images.
+ * @param mode Compositing mode.
+ * @param key_rgb Key color as red, green, blue for COMPOSITE_COLOR_KEY (default to white).
+ *
+ * @return 0 on successful execution, -1 if the mode does not support the format.
+ */
+int compositeImages(const uint8_t *, const uint8_t *, uint8_t *, size_t, PixelFormat, CompositeMode,
+                    const std::array<uint8_t, 3> & = COMPOSITE_KEY_WHITE);
+
+/**
+ * @brief Composites with a given kernel, bypassing the active kernel selection.
+ *
+ * @see compositeImages()
+ *
+ * @param kernel Compositing kernel, must be supported by the CPU.
+ * @param p_base Pointer to the base image pixels.
+ * @param p_overlay Pointer to the overlay image pixels.
+ * @param[out] p_out Pointer to the output pixels.
+ * @param n_pxl Number of pixels in each image.
+ * @param format Pixel format shared by the three images.
+ * @param mode Compositing mode.
+ * @param key_rgb Key color as red, green, blue for COMPOSITE_COLOR_KEY.
+ *
+ * @return 0 on successful execution, -1 if the kernel or mode is not supported.
+ */
+int compositeImagesWith(CompositeKernel, const uint8_t *, const uint8_t *, uint8_t *, size_t, PixelFormat, CompositeMode,
+                        const std::array<uint8_t, 3> &);
+
+#endif
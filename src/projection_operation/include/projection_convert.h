@@ -0,0 +1,34 @@
+// ########################################################################################################
+
+// ========================================= projection_convert.h =========================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_CONVERT_H
+#define _PROJECTION_CONVERT_H
+
+// ================================================== INCLUDE ==================================================
+
+// Local custom libraries
+#include "projection_utils.h"
+
+// ================================================== VARIABLES ==================================================
+
+// Command line options (set with "--<option>=<value>")
+std::string convertModeStr = "to_bin";               // Conversion direction, "to_bin" or "to_xml" ("--mode")
+std::string convertConfigDirPath = CONFIG_DIR_PATH;  // Directory of the cfg_m*_c*.xml files ("--config_dir")
+std::string convertBundlePath = CAL_BUNDLE_PATH;     // Path of the calibration bundle ("--bundle")
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Parses the "--<option>=<value>" command line options into the convert* variables.
+ *
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ *
+ * @return 0 on successful execution, -1 on an unknown or invalid option.
+ */
+int parseConvertArgs(int, char **);
+
+#endif
@@ -11,6 +11,18 @@
 
 // Local custom libraries
 #include "projection_utils.h"
+#include "projection_renderer.h"
+#include "projection_metrics.h"
+
+// Standard Library for render threads and calibration reloading
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <ctime>
+
+// ROS message for live calibration streaming
+#include <std_msgs/Float32MultiArray.h>
 
 // ================================================== VARIABLES ==================================================
 
@@ -48,13 +60,114 @@ bool isWinOnProj = false;  // Flag to indicate if the window is on the projector
 // Number of monitors (autopopulated)
 int nMonitors;             
 
-// Window for OpenGL
+// Window for OpenGL (all windows share objects with the context of the first window)
 GLFWwindow *p_windowIDVec[nProjectors];
 
-// FBO variables for OpenGL
+// FBO variables for OpenGL (FBOs are not shared so each lives in its projector's context)
 std::vector<GLuint> fboIDVec(nProjectors);
 std::vector<GLuint> fboTextureIDVec(nProjectors);
 
+// Wall image texture array for OpenGL (uploaded once and shared by all projector contexts)
+GLuint texWallArrayID = 0;
+
+// Number of rows and columns in the maze (set with the "~maze_size" parameter)
+int mazeSize = MAZE_SIZE;
+
+// Wall image index of every projector, chamber row, chamber column and calibration mode, see getImgProjMapInd()
+// (defaults from initImgProjMap(), overridden with the flat "~image_map" parameter)
+std::vector<int> imgProjMapVec;
+
+// Calibration parameters for each projector, loaded at startup and swapped in by applyCalReload()
+std::vector<std::array<CalibrationParams, N_CAL_MODES>> calParamsVec(nProjectors);
+
+// Calibration directory the XML files and the bundle are loaded from (set from the "~config_dir" ROS parameter)
+std::string calConfigDirPath = CONFIG_DIR_PATH;
+std::string calBundlePath = CAL_BUNDLE_PATH;
+
+// Calibration hot reload variables (a watcher thread reloads changes to calConfigDirPath, the main loop swaps them in)
+bool isCalHotReload = true;                                          // Flag to watch the calibration files (set from the "~hot_reload" ROS parameter)
+std::thread calWatchThread;                                          // Watcher thread
+DirWatcher calDirWatcher;                                            // Watch on calConfigDirPath, used by the watcher thread
+std::mutex calReloadMutex;                                           // Guards the reloaded calibration
+std::vector<std::array<CalibrationParams, N_CAL_MODES>> calReloadVec; // Calibration staged by the watcher and the live stream, waiting to be swapped in
+bool isCalReloadReady = false;                                       // Flag set when calReloadVec holds a new calibration
+std::vector<std::array<long long, N_CAL_MODES>> calLiveTimeVec(nProjectors); // Time each projector and mode was last streamed, 0 once a file replaced it (guarded by calReloadMutex)
+std::atomic<bool> isCalWatchQuit(false);                             // Flag to stop the watcher thread
+
+// Live calibration streaming variables (the calibration node publishes on CAL_LIVE_TOPIC after every control point edit)
+bool isCalLive = false;     // Flag to apply the stream (set from the "~live_calibration" ROS parameter)
+ros::Subscriber calLiveSub; // Subscriber of the live calibration
+
+// Time the calibration files must be quiet before a reload, so a save of several files reloads once
+const int CAL_RELOAD_DEBOUNCE_MS = 100;
+
+// Longest time the watcher blocks before checking isCalWatchQuit
+const int CAL_WATCH_TIMEOUT_MS = 200;
+
+// Wall geometry, image layer and vertex array variables for OpenGL (one per projector)
+std::vector<GLuint> wallVboIDVec(nProjectors);      // Shared buffers, uploaded once per projector
+std::vector<GLuint> wallLayerVboIDVec(nProjectors); // Shared buffers, uploaded once per projector
+std::vector<GLuint> wallVaoIDVec(nProjectors);      // Not shared, created in each projector's context
+
+// Renderer for OpenGL (one per projector window context, shader programs built once and shared)
+std::vector<RendererGL> rendererVec(nProjectors);
+
+// Headless backend variables (render into the FBOs without showing windows, off by default)
+bool isHeadless = false;     // Flag to render headless (set from the "~headless" ROS parameter)
+int nHeadlessFrames = 1;     // Number of frames to render before exiting (set from the "~headless_frames" ROS parameter)
+std::string frameDumpDirPath; // Directory rendered frames are saved to, none if empty (set from the "~frame_dump_dir" ROS parameter)
+std::vector<HeadlessContextEGL> headlessContextVec(nProjectors); // Offscreen context of each projector when built with HEADLESS_EGL
+
+// Golden image regression variables (headless only, set from the "~golden_*" ROS parameters)
+std::string goldenDirPath; // Directory of the reference images "proj_<projector>.png", no comparison if empty
+int goldenTolerance = 2;   // Largest allowed per-channel difference
+int goldenMaxBadPxl = 0;   // Largest allowed number of pixels outside the tolerance
+bool isGoldenUpdate = false; // Flag to save the rendered frames as the new reference images instead of comparing
+
+// Frame timing instrumentation (off by default)
+bool isFrameMetrics = false;                           // Flag to enable frame metrics (set from the "~frame_metrics" ROS parameter)
+std::vector<FrameMetrics> frameMetricsVec(nProjectors); // Render stage timing of each projector, used by the thread rendering it
+FrameMetrics loopMetrics;                              // Calibration loading and event polling timing of the main loop
+
+// Change tracking flags marking what must be updated before a projector is redrawn
+enum ProjDirtyFlag
+{
+    DIRTY_NONE = 0,             // Last presented frame is still valid
+    DIRTY_CALIBRATION = 1 << 0, // Calibration changed, wall geometry must be rebaked
+    DIRTY_WINDOW = 1 << 1,      // Window mode, size or contents changed, FBO must be presented again
+    DIRTY_SCENE = 1 << 2,       // Scene must be rendered into the FBO again
+};
+std::vector<int> projDirtyVec(nProjectors, DIRTY_SCENE | DIRTY_WINDOW); // Dirty flags for each projector (guarded by frameMutex)
+
+// Back buffer size of each projector window, kept by the framebuffer size callback (guarded by frameMutex)
+std::vector<std::array<int, 2>> winFrameSizeVec(nProjectors);
+
+/**
+ * @brief Struct for a reusable barrier that blocks threads until all of them arrive.
+ */
+struct FrameBarrier
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    int n_threads = 0;            // Number of threads that must arrive to release the barrier
+    int n_waiting = 0;            // Number of threads currently waiting
+    unsigned long generation = 0; // Incremented each time the barrier releases
+};
+
+// Render thread variables (one thread and context per projector, off by default)
+bool isRenderThreaded = false;            // Flag to render on per projector threads (set from the "~render_threads" ROS parameter)
+std::vector<std::thread> renderThreadVec; // Render thread of each projector
+std::mutex frameMutex;                    // Guards the frame dispatch state, dirty flags and window sizes
+std::condition_variable frameCond;        // Signals frame dispatch to the render threads and frame completion to the main thread
+unsigned long frameDispatchInd = 0;       // Index of the last frame dispatched to the render threads
+int nFramePending = 0;                    // Number of render threads that have not finished the dispatched frame
+bool isRenderQuit = false;                // Flag to stop the render threads
+bool isRenderErr = false;                 // Flag set by a render thread that failed
+FrameBarrier presentBarrier;              // Barrier the render threads meet at before presenting
+
+// Maximum time to block waiting for window events while no projector is dirty
+const double EVENT_WAIT_TIMEOUT_S = 0.05;
+
 // Monitor variable for OpenGL
 GLFWmonitor *p_monitorID = nullptr;
 GLFWmonitor **pp_monitorIDVec = nullptr;
@@ -89,6 +202,40 @@ void callbackKeyBinding(GLFWwindow *, int, int, int, int);
  */
 void callbackFrameBufferSizeGLFW(GLFWwindow *, int, int);
 
+/**
+ * @brief Callback function for handling window refresh requests.
+ *
+ * Called when the window contents are damaged (e.g. uncovered or restored),
+ * and marks the window's projector dirty so the frame is redrawn.
+ *
+ * @param window Pointer to the GLFW window.
+ */
+void callbackWindowRefreshGLFW(GLFWwindow *);
+
+/**
+ * @brief Sets dirty flags on the projector that owns a window.
+ *
+ * @param p_window_id Pointer to the GLFW window of the projector.
+ * @param flags ProjDirtyFlag bits to set.
+ */
+void markWindowDirty(GLFWwindow *, int);
+
+/**
+ * @brief Gets and clears the dirty flags of a projector.
+ *
+ * @param proj_ind Index of the projector.
+ *
+ * @return ProjDirtyFlag bits that were set.
+ */
+int takeProjDirty(int);
+
+/**
+ * @brief Checks if any projector has dirty flags set.
+ *
+ * @return True if at least one projector needs to be redrawn or presented.
+ */
+bool isAnyProjDirty();
+
 /**
  * @brief Callback function for handling errors.
  *
@@ -104,6 +251,9 @@ static void callbackErrorGLFW(int, const char *);
  * @brief Checks for OpenGL errors and logs them.
  * Should be called after OpenGL API calls.
  *
+ * @note glGetError() stalls the pipeline, so the check only runs when isGLSyncCheck is set.
+ *       Otherwise errors are reported asynchronously by the debug output callback.
+ *
  * @example checkErrorGL(__LINE__, __FILE__);
  *
  * @param line Line number where the function is called.
@@ -134,6 +284,9 @@ int checkErrorGLFW(int, const char *, const char * = nullptr);
  * This function creates a GLFW window, sets its OpenGL context and callbacks, and initializes
  * an FBO and texture to be used for offscreen rendering.
  *
+ * Windows after the first are created sharing objects (textures, buffers and shader programs)
+ * with the first window's context, so resources only need to be uploaded once.
+ *
  * @param pp_window_id GLFWwindow pointer array, where each pointer corresponds to a projector window.
  * @param win_ind Index of the window for which the setup is to be done.
  * @param pp_r_monitor_id Reference to the GLFWmonitor pointer array.
@@ -145,6 +298,41 @@ int checkErrorGLFW(int, const char *, const char * = nullptr);
  */
 int setupProjGLFW(GLFWwindow **, int, GLFWmonitor **&, int, GLuint &, GLuint &);
 
+/**
+ * @brief Set up an EGL headless context and its associated Framebuffer Object (FBO) and texture.
+ *
+ * Used instead of setupProjGLFW() by the headless backend when built with HEADLESS_EGL. Contexts
+ * after the first share objects with the first one, like the windows.
+ *
+ * @param win_ind Index of the projector for which the setup is to be done.
+ * @param r_fbo_id Reference to the GLuint variable where the generated FBO ID will be stored.
+ * @param r_fbo_texture_id Reference to the GLuint variable where the generated FBO texture ID will be stored.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int setupProjHeadlessEGL(int, GLuint &, GLuint &);
+
+/**
+ * @brief Creates the Framebuffer Object (FBO) and texture a projector renders into.
+ *
+ * @note The projector's context must be current.
+ *
+ * @param r_fbo_id Reference to the GLuint variable where the generated FBO ID will be stored.
+ * @param r_fbo_texture_id Reference to the GLuint variable where the generated FBO texture ID will be stored.
+ *
+ * @return 0 on successful execution, -1 if the FBO is not complete.
+ */
+int createProjFBO(GLuint &, GLuint &);
+
+/**
+ * @brief Makes a projector's context current, its window's or its EGL headless context.
+ *
+ * @param proj_ind Index of the projector.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int makeProjContextCurrent(int);
+
 /**
  * @brief Changes the display mode and monitor of the application window.
  *
@@ -156,7 +344,8 @@ int setupProjGLFW(GLFWwindow **, int, GLFWmonitor **&, int, GLuint &, GLuint &);
  * corner of the selected monitor.
  *
  * @note The global variables monitor, monitors, imgMonNumInd, window, and isFullScreen are
- *       used to control the behavior of this function.
+ *       used to control the behavior of this function. Does not touch the window's OpenGL
+ *       context, so it is safe while a render thread owns it.
  *       Will only exicute if monotor parameters have changed.
  *
  * @param p_window_id Pointer to the GLFWwindow pointer that will be updated.
@@ -170,30 +359,214 @@ int setupProjGLFW(GLFWwindow **, int, GLFWmonitor **&, int, GLuint &, GLuint &);
 int updateWindowMonMode(GLFWwindow *, int, GLFWmonitor **&, int, bool);
 
 /**
- * @brief Draws a textured rectangle using OpenGL.
+ * @brief Bakes the warped wall geometry of a projector into its vertex buffer.
+ *
+ * The corners of every wall and calibration mode are computed with computeWallVertices()
+ * and uploaded to a single vertex buffer, so the frame loop does no geometry math.
+ * Should be called at startup and whenever the projector's calibration changes.
+ *
+ * @note The projector window's context must be current.
+ *
+ * @param r_cal_params_arr Reference to the calibration parameters of the projector, indexed by calibration mode.
+ * @param[out] r_vbo_id Reference to the vertex buffer ID, generated if it is 0.
+ *
+ * @return 0 if no errors, -1 if error.
+ */
+int updateWallGeometry(std::array<CalibrationParams, N_CAL_MODES> &, GLuint &);
+
+/**
+ * @brief Uploads the texture array layer of every wall of a projector into its layer buffer.
  *
- * @param quad_vertices_vec Vector of vertex/corner points for a rectangular image.
+ * The layers are taken from imgProjMapVec in the same calibration mode, row and column order
+ * as the wall geometry. Called once at startup, the image map is fixed by the "~image_map" parameter.
+ *
+ * @note The projector window's context must be current.
+ *
+ * @param proj_ind Index of the projector.
+ * @param[out] r_vbo_id Reference to the layer buffer ID, generated if it is 0.
  *
  * @return 0 if no errors, -1 if error.
  */
-int drawQuadImage(std::vector<cv::Point2f>);
+int updateWallImages(int, GLuint &);
 
 /**
  * @brief Draws walls on the OpenGL window.
  *
- * This function is responsible for drawing the walls on the OpenGL window.
- * It iterates through each calibration mode and each wall in the maze to
- * draw the corresponding image.
+ * All walls of every calibration mode are drawn with a single instanced draw call,
+ * each wall sampling its image from the projector's wall texture array.
  *
- * @param proj_ind Index of the projector being used.
- * @param mon_iind Index of the projector monitor being used.
- * @param p_window_id Pointer to the GLFW window.
- * @param fbo_texture_id Framebuffer Object's texture ID.
- * @param r_image_id_vec Reference to the vector containing image IDs.
+ * @param r_renderer Reference to the renderer of the projector window context.
+ * @param wall_vao_id Vertex array holding the baked wall geometry and image layers of the projector.
+ * @param texture_array_id Texture array holding the wall images.
  *
  * @return Returns 0 on success, -1 otherwise.
  */
-int drawWalls(int, int, GLFWwindow *, GLuint, std::vector<ILuint> &);
+int drawWalls(RendererGL &, GLuint, GLuint);
+
+/**
+ * @brief Renders a projector's scene into its FBO if the scene changed.
+ *
+ * Rebakes the wall geometry if flagged by DIRTY_CALIBRATION and draws the walls into the FBO
+ * at full projector resolution. Does nothing if only DIRTY_WINDOW is set, since the FBO still
+ * holds the last frame.
+ *
+ * @note The projector window's context must be current.
+ *
+ * @param proj_ind Index of the projector.
+ * @param dirty_flags ProjDirtyFlag bits taken from the projector with takeProjDirty().
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int renderProjFrame(int, int);
+
+/**
+ * @brief Presents a projector's FBO by blitting it to the window and swapping buffers.
+ *
+ * @note The projector window's context must be current.
+ *
+ * @param proj_ind Index of the projector.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int presentProjFrame(int);
+
+/**
+ * @brief Reads a projector's FBO back into an image.
+ *
+ * @note The projector window's context must be current.
+ *
+ * @param proj_ind Index of the projector.
+ * @param[out] r_frame_mat Reference to the image to fill, as 8-bit BGR with the top row first.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int readProjFrame(int, cv::Mat &);
+
+/**
+ * @brief Renders a fixed number of frames for every projector without presenting them.
+ *
+ * Used by the headless backend. Each frame is rendered into the projector's FBO and,
+ * if frameDumpDirPath is set, saved as "proj_<projector>_frame_<frame>.png".
+ *
+ * @param n_frames Number of frames to render.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int renderHeadlessFrames(int);
+
+/**
+ * @brief Compares the last rendered frame of every projector against its reference image.
+ *
+ * The reference images are read from goldenDirPath. A projector fails if more than goldenMaxBadPxl
+ * pixels differ by more than goldenTolerance, in which case a diff heatmap is saved next to the
+ * reference as "proj_<projector>_diff.png". With isGoldenUpdate set the frames are saved as the
+ * new references instead.
+ *
+ * @return 0 if all projectors match, -1 on mismatch or failure.
+ */
+int compareGoldenFrames();
+
+/**
+ * @brief Blocks until every thread of the barrier has called this function.
+ *
+ * @param r_barrier Reference to the barrier.
+ */
+void waitFrameBarrier(FrameBarrier &);
+
+/**
+ * @brief Render thread loop of one projector.
+ *
+ * Keeps the projector's context current and, for every frame dispatched by the main thread,
+ * renders the scene if dirty, waits at the present barrier for the other projectors and then
+ * presents, so all projectors swap the same logical frame together.
+ *
+ * @param proj_ind Index of the projector.
+ */
+void renderThreadLoop(int);
+
+/**
+ * @brief Starts one render thread per projector.
+ *
+ * The main thread releases its current context and keeps handling GLFW events and ROS.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int startRenderThreads();
+
+/**
+ * @brief Stops the render threads after the frame in flight finishes and releases their contexts.
+ */
+void stopRenderThreads();
+
+/**
+ * @brief Dispatches a new frame to the render threads if a projector is dirty and no frame is in flight.
+ *
+ * @return 0 on successful execution, -1 if a render thread reported an error.
+ */
+int dispatchRenderFrame();
+
+/**
+ * @brief Loads the calibration of every projector from calConfigDirPath.
+ *
+ * Reads each projector's calibration from the calibration bundle if it is valid, has entries for
+ * the projector's monitor and no XML file of that monitor was written in the same second or later,
+ * otherwise from that monitor's XML files, so both the calibration UI and hand edits of the XML
+ * files are picked up.
+ *
+ * @param[out] r_cal_params_vec Reference to the calibration of each projector.
+ * @param[out] r_file_time_vec Reference to the modification time of the file each projector and
+ *             calibration mode was read from, in seconds since the epoch.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int loadProjCalibration(std::vector<std::array<CalibrationParams, N_CAL_MODES>> &, std::vector<std::array<long long, N_CAL_MODES>> &);
+
+/**
+ * @brief Calibration watcher thread loop.
+ *
+ * Waits for changes to calConfigDirPath, waits until the directory has been quiet for
+ * CAL_RELOAD_DEBOUNCE_MS, reloads the calibration with loadProjCalibration() and merges it into
+ * calReloadVec one projector and calibration mode at a time, waking the main thread with
+ * glfwPostEmptyEvent(). Entries streamed after their file was written (see calLiveTimeVec) keep
+ * the streamed calibration, so unsaved live edits survive saves of other monitors or modes. A
+ * failed reload keeps the current calibration.
+ */
+void calWatchLoop();
+
+/**
+ * @brief Starts the calibration watcher thread.
+ *
+ * @return 0 on successful execution, -1 if the directory cannot be watched.
+ */
+int startCalWatch();
+
+/**
+ * @brief Stops the calibration watcher thread.
+ */
+void stopCalWatch();
+
+/**
+ * @brief ROS callback applying a live calibration message from the calibration node.
+ *
+ * Runs on the ROS spinner thread. Computes the wall parameter field of the received calibration
+ * and stages it in calReloadVec for every projector on the message's monitor, on top of any
+ * reload not swapped in yet, and records the time in calLiveTimeVec, then wakes the main loop so applyCalReload() swaps it in before
+ * the next frame.
+ *
+ * @param msg Live calibration message, see packCalibrationMsg().
+ */
+void callbackCalLive(const std_msgs::Float32MultiArray::ConstPtr &);
+
+/**
+ * @brief Swaps a reloaded or streamed calibration into calParamsVec between frames.
+ *
+ * Called by the main loop before dispatching a frame. With render threads it waits for the frame
+ * in flight to finish, checked without blocking, so the render threads never see a half swapped
+ * calibration. Marks every projector DIRTY_CALIBRATION so the next frame rebakes its geometry.
+ *
+ * @return True if a calibration was swapped in.
+ */
+bool applyCalReload();
 
 /**
  * @brief  Entry point for the projection_display ROS node.
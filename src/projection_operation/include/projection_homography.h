@@ -0,0 +1,94 @@
+// ########################################################################################################
+
+// ======================================= projection_homography.h =======================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_HOMOGRAPHY_H
+#define _PROJECTION_HOMOGRAPHY_H
+
+// ================================================== INCLUDE ==================================================
+
+// OpenCV for the cv::Mat conversions
+#include <opencv2/core.hpp>
+
+// Standard Library for various utilities
+#include <array>
+#include <cstddef>
+
+// ================================================== VARIABLES ==================================================
+
+/**
+ * @brief Fixed size 3x3 homography stored row-major in single precision.
+ *
+ * A literal aggregate, so values can be declared constexpr and passed around without heap
+ * allocations, unlike a cv::Mat.
+ */
+struct Homography
+{
+    std::array<float, 9> h; // h00, h01, h02, h10, h11, h12, h20, h21, h22
+};
+
+// Identity homography
+constexpr Homography HOMOGRAPHY_IDENTITY = {{{1.0f, 0.0f, 0.0f,
+                                              0.0f, 1.0f, 0.0f,
+                                              0.0f, 0.0f, 1.0f}}};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Copies a 3x3 cv::Mat homography into a Homography.
+ *
+ * @param hom_mat 3x3 homography matrix of type CV_32F or CV_64F.
+ * @param[out] r_hom Reference to the homography to fill.
+ *
+ * @return 0 on successful execution, -1 if the matrix is not 3x3 CV_32F or CV_64F.
+ */
+int homographyFromMat(const cv::Mat &, Homography &);
+
+/**
+ * @brief Copies a Homography into a 3x3 CV_32F cv::Mat.
+ *
+ * @param hom Homography to copy.
+ * @param[out] r_hom_mat Reference to the matrix to fill, reallocated if needed.
+ */
+void homographyToMat(const Homography &, cv::Mat &);
+
+/**
+ * @brief Solves the homography mapping 4 source points exactly onto 4 destination points.
+ *
+ * Closed form used in place of a general estimator such as cv::findHomography(): each quad is
+ * mapped from the unit square (Heckbert's square-to-quad) and the result is
+ * H = H_dst * adj(H_src), scaled so h22 = 1. All arithmetic is done in double precision.
+ *
+ * @details
+ * The points of each quad must be given in cyclic order (either direction, same for both quads).
+ * The solve is rejected when
+ * - a quad is not strictly convex, i.e. three of its points are (nearly) collinear, relative
+ *   to the squared size of the quad;
+ * - h22 of the result is (nearly) zero, so it cannot be normalized;
+ * - any coefficient is not finite.
+ *
+ * @param p_src_xy Pointer to the x, y of the 4 source points, interleaved.
+ * @param p_dst_xy Pointer to the x, y of the 4 destination points, interleaved.
+ * @param[out] r_hom Reference to the solved homography, unchanged on failure.
+ *
+ * @return 0 on successful execution, -1 if the configuration is degenerate.
+ */
+int solveHomography4Point(const float *, const float *, Homography &);
+
+/**
+ * @brief Warps a batch of points with a homography.
+ *
+ * Each point is mapped to ((h00*x + h01*y + h02) / w, (h10*x + h11*y + h12) / w) with
+ * w = h20*x + h21*y + h22. Points are processed 4 at a time with SSE where available; the result
+ * is bit-identical to the scalar path.
+ *
+ * @param hom Homography to apply.
+ * @param p_xy_in Pointer to the x, y coordinates of the points, interleaved.
+ * @param[out] p_xy_out Pointer to the storage for the warped points, interleaved. May be the same as p_xy_in.
+ * @param n_pts Number of points.
+ */
+void transformPoints(const Homography &, const float *, float *, size_t);
+
+#endif
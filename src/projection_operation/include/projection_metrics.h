@@ -0,0 +1,190 @@
+// ######################################################################################################
+
+// ======================================== projection_metrics.h ========================================
+
+// ######################################################################################################
+
+#ifndef _PROJECTION_METRICS_H
+#define _PROJECTION_METRICS_H
+
+// ================================================== INCLUDE ==================================================
+
+// Check if APIENTRY is already defined and undefine it
+#ifdef APIENTRY
+#undef APIENTRY
+#endif
+
+// OpenGL (GLAD) for timer queries
+#include "glad/glad.h"
+
+// Undefine APIENTRY after GLAD header
+#ifdef APIENTRY
+#undef APIENTRY
+#endif
+
+// ROS for logging
+#include <ros/console.h>
+
+// Standard Library for various utilities
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// ================================================== VARIABLES ==================================================
+
+/**
+ * @brief Render loop stages timed on the CPU.
+ */
+enum FrameStage
+{
+    STAGE_CALIBRATION = 0, // Calibration XML loading and homography computation
+    STAGE_GEOMETRY,        // Wall geometry baking and upload
+    STAGE_TEXTURE,         // Wall image compositing, texture upload and bind
+    STAGE_DRAW,            // Draw call submission
+    STAGE_SWAP,            // Frame presentation and glfwSwapBuffers
+    STAGE_EVENTS,          // GLFW event polling or waiting
+    N_FRAME_STAGES,
+};
+
+// Number of GL_TIME_ELAPSED queries in flight per context before timing is skipped
+const int N_GPU_TIMER_QUERIES = 4;
+
+// Number of samples kept by each rolling window
+const size_t METRICS_WINDOW_SIZE = 600;
+
+// Interval between logged metric summaries
+const double METRICS_LOG_INTERVAL_S = 5.0;
+
+/**
+ * @brief Struct for a fixed size window of the most recent samples.
+ */
+struct RollingSamples
+{
+    std::vector<float> sample_vec; // Samples in milliseconds, overwritten oldest first once full
+    size_t next_ind = 0;           // Index the next sample is written to once full
+};
+
+/**
+ * @brief Struct holding the frame timing of one projector window (or one node loop).
+ *
+ * CPU stage times are accumulated over a frame with beginStage()/endStage() and pushed into
+ * the rolling windows by endFrame(). GPU time is measured with a ring of GL_TIME_ELAPSED
+ * queries that are read back frames later, only once their results are available, so timing
+ * never stalls the pipeline.
+ *
+ * @note The query objects belong to the context current during initFrameMetrics(), and each
+ *       instance must only be used from one thread.
+ */
+struct FrameMetrics
+{
+    std::string label;                                                       // Label used when logging
+    std::array<RollingSamples, N_FRAME_STAGES> stage_samples;                // CPU time of each stage per frame
+    RollingSamples frame_samples;                                            // CPU time between consecutive frames
+    RollingSamples gpu_samples;                                              // GPU time of the timed draw per frame
+    std::array<double, N_FRAME_STAGES> stage_ms_arr = {};                    // CPU time of each stage in the current frame
+    std::array<std::chrono::steady_clock::time_point, N_FRAME_STAGES> stage_start_arr; // Start time of each running stage
+    std::chrono::steady_clock::time_point frame_last;                        // End time of the last frame
+    std::chrono::steady_clock::time_point log_last;                          // Time of the last logged summary
+    std::array<GLuint, N_GPU_TIMER_QUERIES> query_id_arr = {};               // GL_TIME_ELAPSED query ring
+    int query_write_ind = 0;                                                 // Next query to begin
+    int query_read_ind = 0;                                                  // Oldest query not yet read back
+    int n_query_pending = 0;                                                 // Number of queries not yet read back
+    bool is_query_active = false;                                            // Flag to indicate a query was begun this frame
+    bool is_enabled = false;                                                 // Flag to enable the measurements
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Initializes frame metrics and creates the GPU timer queries.
+ *
+ * @note If enabled, the OpenGL context the metrics are used with must be current. Pass a
+ *       false is_gpu flag for metrics that are not tied to a context (e.g. event polling).
+ *
+ * @param[out] r_metrics Reference to the metrics to initialize.
+ * @param label_str Label used when logging the summary.
+ * @param is_enabled Flag to enable the measurements, all calls are no-ops otherwise.
+ * @param is_gpu Flag to create the GPU timer queries (default to true).
+ */
+void initFrameMetrics(FrameMetrics &, const std::string &, bool, bool = true);
+
+/**
+ * @brief Deletes the GPU timer queries of the metrics.
+ *
+ * @note The context the metrics were initialized with must be current.
+ *
+ * @param r_metrics Reference to the metrics to clean up.
+ */
+void deleteFrameMetrics(FrameMetrics &);
+
+/**
+ * @brief Starts the CPU timer of a stage.
+ *
+ * @param r_metrics Reference to the metrics.
+ * @param stage Stage to time.
+ */
+void beginStage(FrameMetrics &, FrameStage);
+
+/**
+ * @brief Stops the CPU timer of a stage and adds the elapsed time to the current frame.
+ *
+ * @param r_metrics Reference to the metrics.
+ * @param stage Stage being timed.
+ */
+void endStage(FrameMetrics &, FrameStage);
+
+/**
+ * @brief Begins a GL_TIME_ELAPSED query around the GPU work that follows.
+ *
+ * Skips the measurement if all queries of the ring are still in flight.
+ *
+ * @param r_metrics Reference to the metrics.
+ */
+void beginGPUTimer(FrameMetrics &);
+
+/**
+ * @brief Ends the GL_TIME_ELAPSED query begun by beginGPUTimer().
+ *
+ * @param r_metrics Reference to the metrics.
+ */
+void endGPUTimer(FrameMetrics &);
+
+/**
+ * @brief Pushes the current frame's stage times into the rolling windows.
+ *
+ * Also reads back the finished GPU timer queries and logs a summary every
+ * METRICS_LOG_INTERVAL_S seconds.
+ *
+ * @param r_metrics Reference to the metrics.
+ */
+void endFrame(FrameMetrics &);
+
+/**
+ * @brief Restarts the frame interval at the current time without recording a frame.
+ *
+ * For event driven loops that block while there is nothing to draw, so the time spent
+ * waiting is not counted in the interval of the next frame.
+ *
+ * @param r_metrics Reference to the metrics.
+ */
+void restartFrameInterval(FrameMetrics &);
+
+/**
+ * @brief Computes a percentile of a rolling window.
+ *
+ * @param samples Rolling window of samples.
+ * @param percentile Percentile in the range [0, 100].
+ *
+ * @return Percentile value in milliseconds, 0 if the window is empty.
+ */
+float computePercentile(const RollingSamples &, float);
+
+/**
+ * @brief Logs the p50/p95/p99 of every stage, the frame interval and the GPU time.
+ *
+ * @param metrics Metrics to log.
+ */
+void logFrameMetrics(const FrameMetrics &);
+
+#endif
@@ -0,0 +1,259 @@
+// #######################################################################################################
+
+// ======================================== projection_renderer.h ========================================
+
+// #######################################################################################################
+
+#ifndef _PROJECTION_RENDERER_H
+#define _PROJECTION_RENDERER_H
+
+// ================================================== INCLUDE ==================================================
+
+// Check if APIENTRY is already defined and undefine it
+#ifdef APIENTRY
+#undef APIENTRY
+#endif
+
+// OpenGL (GLAD and GLFW) for graphics and windowing
+#include "glad/glad.h"
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+// Undefine APIENTRY after GLFW and GLAD headers
+#ifdef APIENTRY
+#undef APIENTRY
+#endif
+
+// ROS for logging
+#include <ros/console.h>
+
+// Standard Library for various utilities
+#include <array>
+#include <vector>
+#include <string>
+
+// ================================================== VARIABLES ==================================================
+
+// Number of overlay layers the overlay program composites over the base layer
+const int N_OVERLAY_LAYERS = 3;
+
+// Headless backend, EGL without a window system when built with HEADLESS_EGL, otherwise the GLFW 3.4 null platform
+#ifdef HEADLESS_EGL
+const bool IS_HEADLESS_EGL = true;
+#else
+const bool IS_HEADLESS_EGL = false;
+#endif
+
+/**
+ * @brief Flag to run synchronous glGetError() checks after OpenGL calls.
+ *
+ * Each check stalls the CPU until the GPU catches up, so they are off by default and errors are
+ * reported asynchronously through the KHR_debug message callback (see initDebugOutput()).
+ * Enabled by the GL_SYNC_CHECKS build option or the "~gl_sync_checks" ROS parameter.
+ */
+extern bool isGLSyncCheck;
+
+/**
+ * @brief Struct to hold the OpenGL objects used by the core-profile renderer.
+ *
+ * Three shader programs are used:
+ * - A general program for geometry stored as interleaved x, y (NDC) and u, v (texture coordinate)
+ *   floats, drawn as triangle fans, which covers both the wall quads and the control point circles.
+ * - A wall program that draws every wall of a projector in one instanced call. Each instance reads its
+ *   4 corners from a geometry buffer and its image layer from a layer buffer, and samples a 2D texture array.
+ * - An overlay program for streamed x, y, u, v geometry that samples a base layer of a 2D texture array and
+ *   composites up to N_OVERLAY_LAYERS further layers over it, with white as the transparent key.
+ *
+ * @note Vertex array objects are not shared between OpenGL contexts, so one instance is
+ *       needed per context. Contexts created with a shared context reuse its shader programs.
+ */
+struct RendererGL
+{
+    GLuint program_id = 0;          // Shader program
+    GLint u_color_loc = -1;         // Location of the color uniform
+    GLint u_use_texture_loc = -1;   // Location of the texture enable uniform
+    GLint u_texture_loc = -1;       // Location of the texture sampler uniform
+    GLuint stream_vao_id = 0;       // Vertex array for per-draw streamed vertices
+    GLuint stream_vbo_id = 0;       // Vertex buffer for per-draw streamed vertices
+    GLuint wall_program_id = 0;     // Instanced wall shader program
+    GLuint overlay_program_id = 0;  // Layered overlay shader program
+    GLint u_base_layer_loc = -1;    // Location of the overlay program's base layer uniform
+    GLint u_overlay_layer_loc = -1; // Location of the overlay program's overlay layer array uniform
+    bool is_shared = false;         // Flag to indicate the programs are owned by another renderer
+};
+
+/**
+ * @brief Struct to hold an offscreen OpenGL context of the EGL headless backend.
+ *
+ * The context is made current without a surface, so it only renders into framebuffer objects.
+ * The handles are stored as void pointers to keep the EGL headers out of this header.
+ */
+struct HeadlessContextEGL
+{
+    void *p_display = nullptr;     // EGLDisplay, shared by every context
+    void *p_context = nullptr;     // EGLContext
+    bool is_display_owner = false; // Flag to indicate this context initialized the display and terminates it
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Sets the GLFW window hints for an OpenGL 3.3 core-profile context.
+ *
+ * Must be called before glfwCreateWindow().
+ */
+void setRendererWindowHints();
+
+/**
+ * @brief Sets the GLFW init hints for the GLFW headless backend.
+ *
+ * Selects the null platform, which needs no display server or monitor. Must be called before
+ * glfwInit(). Not used when built with HEADLESS_EGL.
+ *
+ * @return 0 on successful execution, -1 if GLFW is older than 3.4 or was built without the
+ *         null platform, in which case headless rendering is unavailable.
+ */
+int setHeadlessInitHints();
+
+/**
+ * @brief Sets the GLFW window hints for the GLFW headless backend.
+ *
+ * Windows are created hidden and the context is created through OSMesa so rendering runs on
+ * the Mesa software rasterizer. Must be called after setRendererWindowHints() and before
+ * glfwCreateWindow().
+ */
+void setHeadlessWindowHints();
+
+/**
+ * @brief Creates an OpenGL 3.3 core-profile context of the EGL headless backend.
+ *
+ * The first context opens the Mesa surfaceless platform display, which renders on the GPU
+ * render node if there is one and on llvmpipe otherwise, without a display server.
+ *
+ * @param[out] r_context Reference to the context to create.
+ * @param p_shared_context Optional context to share objects with, whose display is reused (default to nullptr).
+ *
+ * @return 0 on successful execution, -1 on failure or when not built with HEADLESS_EGL.
+ */
+int createHeadlessContext(HeadlessContextEGL &, const HeadlessContextEGL * = nullptr);
+
+/**
+ * @brief Makes an EGL headless context current on the calling thread without a surface.
+ *
+ * @param context Context to make current.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int makeHeadlessContextCurrent(const HeadlessContextEGL &);
+
+/**
+ * @brief Destroys an EGL headless context, terminating the display if the context owns it.
+ *
+ * @param[out] r_context Reference to the context to destroy.
+ */
+void deleteHeadlessContext(HeadlessContextEGL &);
+
+/**
+ * @brief Looks up an OpenGL function of the EGL headless backend, for gladLoadGLLoader().
+ *
+ * @param name Name of the function.
+ *
+ * @return Address of the function, nullptr if unavailable.
+ */
+void *getHeadlessProcAddress(const char *);
+
+/**
+ * @brief Enables OpenGL debug output for the current context and installs the message callback.
+ *
+ * Errors and warnings are logged as the driver reports them without stalling the pipeline.
+ * When isGLSyncCheck is set the output is made synchronous so messages are logged from
+ * inside the offending call.
+ *
+ * @note Requires an OpenGL 4.3 context or the KHR_debug extension, otherwise a warning is
+ *       logged and isGLSyncCheck is forced on so errors are still caught by the glGetError()
+ *       checks.
+ *
+ * @return 0 on successful execution, -1 if debug output is unavailable.
+ */
+int initDebugOutput();
+
+/**
+ * @brief Compiles the renderer shader programs and creates the streaming vertex buffer.
+ *
+ * @note The OpenGL context that will use the renderer must be current and GLAD must be loaded.
+ *
+ * @param[out] r_renderer Reference to the renderer struct to initialize.
+ * @param p_shared_renderer Optional renderer of a context sharing objects with the current one,
+ *                          whose shader programs are reused instead of compiled again (default to nullptr).
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int initRenderer(RendererGL &, const RendererGL * = nullptr);
+
+/**
+ * @brief Deletes the OpenGL objects owned by the renderer.
+ *
+ * @note Renderers reusing shared programs must be deleted before the renderer that built them.
+ *
+ * @param r_renderer Reference to the renderer struct to clean up.
+ */
+void deleteRenderer(RendererGL &);
+
+/**
+ * @brief Creates a vertex array object for instanced wall drawing.
+ *
+ * @param geometry_vbo_id Vertex buffer holding 8 floats per wall: the x, y of the top-left, top-right,
+ *                        bottom-right and bottom-left corners.
+ * @param layer_vbo_id Vertex buffer holding one GLint texture array layer per wall.
+ * @param[out] r_vao_id Reference to the vertex array ID, generated if it is 0.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int createWallVertexArray(GLuint, GLuint, GLuint &);
+
+/**
+ * @brief Draws every wall of a wall vertex array in a single instanced call.
+ *
+ * @param r_renderer Reference to the initialized renderer.
+ * @param vao_id Wall vertex array created with createWallVertexArray().
+ * @param n_walls Number of walls (instances) to draw.
+ * @param texture_array_id 2D texture array holding the wall images.
+ */
+void drawWallsInstanced(RendererGL &, GLuint, GLsizei, GLuint);
+
+/**
+ * @brief Streams interleaved x, y, u, v vertices and draws them as a textured triangle fan.
+ *
+ * @param r_renderer Reference to the initialized renderer.
+ * @param p_vertices Pointer to the interleaved vertex data.
+ * @param n_vertices Number of vertices in the fan.
+ * @param texture_id Texture to map onto the fan.
+ */
+void drawStreamTextured(RendererGL &, const GLfloat *, GLsizei, GLuint);
+
+/**
+ * @brief Streams interleaved x, y, u, v vertices and draws them as a triangle fan textured with composited array layers.
+ *
+ * The base layer is drawn and every overlay layer is composited over it in order. Overlay texels
+ * that are white are transparent, so the state images only cover the base where they have content.
+ *
+ * @param r_renderer Reference to the initialized renderer.
+ * @param p_vertices Pointer to the interleaved vertex data.
+ * @param n_vertices Number of vertices in the fan.
+ * @param texture_array_id 2D texture array holding the base and overlay images.
+ * @param base_layer Layer of the base image.
+ * @param overlay_layer_arr Layers of the overlay images, negative entries are skipped.
+ */
+void drawStreamLayered(RendererGL &, const GLfloat *, GLsizei, GLuint, GLint, const std::array<GLint, N_OVERLAY_LAYERS> &);
+
+/**
+ * @brief Streams interleaved x, y, u, v vertices and draws them as a solid colored triangle fan.
+ *
+ * @param r_renderer Reference to the initialized renderer.
+ * @param p_vertices Pointer to the interleaved vertex data (texture coordinates are ignored).
+ * @param n_vertices Number of vertices in the fan.
+ * @param rgb_vec Vector of rgb values to color the fan.
+ */
+void drawStreamColored(RendererGL &, const GLfloat *, GLsizei, const std::vector<float> &);
+
+#endif
@@ -44,6 +44,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <array>
 #include <vector>
@@ -60,6 +61,12 @@
 #include "opencv2/imgcodecs.hpp"
 #include "opencv2/highgui.hpp"
 
+// Local custom libraries
+#include "projection_composite.h"
+#include "projection_homography.h"
+#include "projection_bundle.h"
+#include "projection_watch.h"
+
 // ================================================== VARIABLES ==================================================
 
 /**
@@ -75,6 +82,9 @@
  * - Calibration Mode: 0 to 2 (represents l_wall, m_wall, r_wall)
  *
  * Format: array[4][3][3][3] = array[Projector][Chamber Row][Chamber Column][Calibration Mode{Left, Center, Right}]
+ *
+ * @note These are the defaults for a MAZE_SIZE maze. At runtime the map is held in a flat vector
+ *       sized for the configured maze, see initImgProjMap() and getImgProjMapInd().
  */
 
 // Template of 4D array for hardcoded image indices to display
@@ -207,12 +217,38 @@ extern const std::string package_path = ros::package::getPath("projection_operat
 extern const std::string workspace_path = package_path.substr(0, package_path.rfind("/src"));
 extern const std::string CONFIG_DIR_PATH = workspace_path + "/data/proj_cfg";
 
+// Binary calibration bundle built from the XML files in CONFIG_DIR_PATH, see projection_bundle.h
+extern const std::string CAL_BUNDLE_FILE_NAME = "proj_cfg.bin";
+extern const std::string CAL_BUNDLE_PATH = CONFIG_DIR_PATH + "/" + CAL_BUNDLE_FILE_NAME;
+
+// Number of monitor indices probed for XML files when building the calibration bundle
+extern const int N_CAL_BUNDLE_MON = 8;
+
 // Directory paths for configuration images
 extern const std::string IMAGE_TOP_DIR_PATH = workspace_path + "/data/proj_img";
 
-// Number of rows and columns in the maze
+// Default number of rows and columns in the maze, the nodes override it with the "~maze_size" parameter
 extern const int MAZE_SIZE = 3;
 
+// Range of supported maze sizes
+extern const int MIN_MAZE_SIZE = 2;
+extern const int MAX_MAZE_SIZE = 32;
+
+// Number of projectors covered by IMG_PROJ_MAP
+extern const int N_IMG_PROJ_MAP_PROJ = 4;
+
+// Number of calibration modes (left, middle and right walls)
+extern const int N_CAL_MODES = 3;
+
+// Topic the calibration node streams its calibration on after every key event, see packCalibrationMsg()
+extern const std::string CAL_LIVE_TOPIC = "/projection_calibration/live";
+
+// Number of floats in a live calibration message (monitor, calibration mode, 4x6 control point parameters, 3x3 homography)
+extern const int CAL_LIVE_MSG_SIZE = 2 + 4 * 6 + 9;
+
+// Number of floats per wall in the baked geometry buffers (x, y for each of the 4 corners)
+extern const int WALL_GEOMETRY_SIZE = 8;
+
 // Wall image size and spacing (pixels)
 extern const int WALL_WIDTH_PXL = 300;
 extern const int WALL_HEIGHT_PXL = 540;
@@ -224,7 +260,7 @@ extern const float CP_RADIUS_NDC = 0.005f;
 const float originPlaneWidth = 0.3f;
 const float originPlaneHeight = 0.6f;
 
-// Wall spacing (NDC)
+// Wall spacing for the default maze size (NDC), see WallParamField for the configured one
 extern const float WALL_SPACE_X = originPlaneWidth / (float(MAZE_SIZE) - 1);  // Wall spacing on X axis NDC
 extern const float WALL_SPACE_Y = originPlaneHeight / (float(MAZE_SIZE) - 1); // Wall spacing on Y axis NDC
 
@@ -297,20 +333,55 @@ extern const std::array<std::array<float, 6>, 4> CTRL_POINT_PARAMS = {{
 
 /**
  * @brief Struct to hold debugging parameters for the maze.
+ *
+ * Values are stored flat, indexed by row * grid_size + col, and resized by dbStoreQuadParams().
  */
 struct DebugParams
 {
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_width;                              // Width values
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_height;                             // Height values
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_shear_x;                            // Shear x values
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_shear_y;                            // Shear y values
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_origin_x;                           // X values
-    std::array<std::array<float, MAZE_SIZE>, MAZE_SIZE> quad_origin_y;                           // Y values
-    std::array<std::array<std::vector<cv::Point2f>, MAZE_SIZE>, MAZE_SIZE> quad_vertices_raw;    // Wall quad vertices pre-warp
-    std::array<std::array<std::vector<cv::Point2f>, MAZE_SIZE>, MAZE_SIZE> quad_vertices_warped; // Wall quad vertices warped
+    int grid_size = 0;                                          // Number of rows and columns stored
+    std::vector<float> quad_width;                              // Width values
+    std::vector<float> quad_height;                             // Height values
+    std::vector<float> quad_shear_x;                            // Shear x values
+    std::vector<float> quad_shear_y;                            // Shear y values
+    std::vector<float> quad_origin_x;                           // X values
+    std::vector<float> quad_origin_y;                           // Y values
+    std::vector<std::vector<cv::Point2f>> quad_vertices_raw;    // Wall quad vertices pre-warp
+    std::vector<std::vector<cv::Point2f>> quad_vertices_warped; // Wall quad vertices warped
 };
 extern DebugParams dbParams;
 
+/**
+ * @brief Struct holding the interpolated wall parameters of every cell in the maze grid.
+ *
+ * Structure of arrays indexed by grid_row_i * grid_size + grid_col_i, filled by
+ * computeWallParamField() whenever the control point parameters change so the per-frame
+ * geometry code only reads it.
+ */
+struct WallParamField
+{
+    int grid_size = 0;              // Number of cells along one axis
+    float wall_space_x = 0.0f;      // Wall spacing on X axis (NDC)
+    float wall_space_y = 0.0f;      // Wall spacing on Y axis (NDC)
+    std::vector<float> width_vec;   // Wall width (NDC)
+    std::vector<float> height_vec;  // Wall height (NDC)
+    std::vector<float> shear_x_vec; // Wall x shear
+    std::vector<float> shear_y_vec; // Wall y shear
+};
+
+/**
+ * @brief Struct to hold the calibration for a single monitor and calibration mode.
+ *
+ * Instances are filled once from the XML configuration files so that the render loop
+ * can read the control point parameters, homography matrix and wall parameter field without
+ * touching the disk.
+ */
+struct CalibrationParams
+{
+    std::array<std::array<float, 6>, 4> ctrl_point_params; // Control point parameters (x, y, width, height, shear x, shear y)
+    cv::Mat hom_mat = cv::Mat::eye(3, 3, CV_32F);           // Homography matrix (CV_32F)
+    WallParamField param_field;                             // Wall parameters interpolated from the control points
+};
+
 // ================================================== FUNCTIONS ==================================================
 
 /**
@@ -348,7 +419,7 @@ std::string formatCoordinatesFilePathXML(int, int, std::string);
  *
  * @note Uses pugiXML for XML parsing.
  *
- * @param[out] r_hom_mat Reference to the homography matrix to populate.
+ * @param[out] r_hom_mat Reference to the homography matrix to populate, (re)allocated as a 3x3 CV_32F matrix.
  * @param[out] r_ctrl_point_params Reference to a 4x6 array containing control point parameters (x, y, width, height, shear x, shear y).
  * @param full_path Path to the XML file.
  * @param verbose_level Level of verbosity for printing loaded data (0:nothing, 1:file name, 2:control point parameters, 3:homography matrix).
@@ -387,11 +458,96 @@ int loadCoordinatesXML(cv::Mat &, std::array<std::array<float, 6>, 4> &, std::st
  * </config>
  * @endcode
  *
+ * The document is written to "<full_path>.tmp" and renamed over the file, so readers never
+ * see a partially written file.
+ *
  * @param hom_mat The homography matrix used to warp perspective.
  * @param ctrl_point_params A 4x6 array containing control point parameters (x, y, width, height, shear x, shear y).
  * @param full_path Path to the XML file.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int saveCoordinatesXML(cv::Mat, std::array<std::array<float, 6>, 4>, std::string);
+
+/**
+ * @brief Loads the calibration for every calibration mode of a monitor.
+ *
+ * Reads the `cfg_m<mon>_c<cal>.xml` file for each calibration mode and computes the
+ * homography matrix and wall parameter field from the loaded control point parameters.
+ *
+ * @param mon_id_ind Index of the monitor to load the calibration for.
+ * @param config_dir_path Path to the directory containing the XML files.
+ * @param grid_size Number of rows and columns in the maze.
+ * @param[out] r_cal_params_arr Reference to the array of calibration parameters, indexed by calibration mode.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int loadCalibrationParams(int, std::string, int, std::array<CalibrationParams, N_CAL_MODES> &);
+
+/**
+ * @brief Loads the calibration for every calibration mode of a monitor from a calibration bundle.
+ *
+ * Copies the control point parameters and homography matrix straight out of the mapped bundle,
+ * then computes the wall parameter field for the maze size.
+ *
+ * @param bundle Open calibration bundle, see openCalibrationBundle().
+ * @param mon_id_ind Index of the monitor to load the calibration for.
+ * @param grid_size Number of rows and columns in the maze.
+ * @param[out] r_cal_params_arr Reference to the array of calibration parameters, indexed by calibration mode.
+ *
+ * @return 0 on successful execution, -1 if the bundle is missing a calibration mode of the monitor.
+ */
+int loadCalibrationParams(const MappedCalibrationBundle &, int, int, std::array<CalibrationParams, N_CAL_MODES> &);
+
+/**
+ * @brief Builds a calibration bundle from the `cfg_m<mon>_c<cal>.xml` files of a directory.
+ *
+ * Monitors 0 to N_CAL_BUNDLE_MON - 1 are probed and each monitor with a file for every calibration
+ * mode is added. The homography is recomputed from the control points, as loadCalibrationParams() does.
+ *
+ * @param config_dir_path Path to the directory containing the XML files.
+ * @param bundle_path Path of the bundle file to write.
+ *
+ * @return 0 on successful execution, -1 on failure or if no monitor has a complete calibration.
+ */
+int convertCalibrationXMLToBundle(std::string, std::string);
+
+/**
+ * @brief Writes every entry of a calibration bundle back to `cfg_m<mon>_c<cal>.xml` files.
+ *
+ * @param bundle_path Path of the bundle file to read.
+ * @param config_dir_path Path to the directory the XML files are saved to.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int convertCalibrationBundleToXML(std::string, std::string);
+
+/**
+ * @brief Packs the calibration of a monitor and calibration mode into the data of a live calibration message.
+ *
+ * Layout: monitor, calibration mode, the 4x6 control point parameters row by row and the 3x3
+ * homography matrix row by row, CAL_LIVE_MSG_SIZE floats in total.
+ *
+ * @param mon_id_ind Index of the monitor.
+ * @param mode_cal_ind Index of the calibration mode.
+ * @param ctrl_point_params Control point parameters.
+ * @param hom_mat Homography matrix (CV_32F or CV_64F).
+ * @param[out] r_data_vec Reference to the message data.
+ */
+void packCalibrationMsg(int, int, const std::array<std::array<float, 6>, 4> &, const cv::Mat &, std::vector<float> &);
+
+/**
+ * @brief Unpacks and validates the data of a live calibration message.
+ *
+ * @param data_vec Message data, see packCalibrationMsg().
+ * @param[out] r_mon_id_ind Reference to the monitor index.
+ * @param[out] r_mode_cal_ind Reference to the calibration mode index.
+ * @param[out] r_ctrl_point_params Reference to the control point parameters.
+ * @param[out] r_hom_mat Reference to the homography matrix, a new CV_32F matrix.
+ *
+ * @return 0 on successful execution, -1 if the size, an index or a value is invalid.
  */
-void saveCoordinatesXML(cv::Mat, std::array<std::array<float, 6>, 4>, std::string);
+int unpackCalibrationMsg(const std::vector<float> &, int &, int &, std::array<std::array<float, 6>, 4> &, cv::Mat &);
 
 /**
  * @brief Loads images from specified file paths and stores their IDs in a reference vector.
@@ -416,12 +572,29 @@ int loadImgTextures(std::vector<std::string>, std::vector<ILuint> &);
  */
 int deleteImgTextures(std::vector<ILuint> &);
 
+/**
+ * @brief Uploads DevIL images to the layers of a resident OpenGL 2D texture array.
+ *
+ * Each image is uploaded once, with the layer index matching the image's index in the
+ * input vector, so that all walls can be drawn from a single texture binding.
+ *
+ * @note Texture objects belong to the OpenGL context (or share group) that is current when
+ *       this function is called.
+ *
+ * @param image_id_vec Vector of DevIL image IDs returned by loadImgTextures(), all the same size.
+ * @param[out] r_texture_array_id Reference to the GLuint where the texture array ID will be stored.
+ *
+ * @return OpenGL status: 0 on successful execution, -1 on failure.
+ */
+int loadGLTextureArray(std::vector<ILuint>, GLuint &);
+
 /**
  * @brief Merges two images by overlaying non-white pixels from the second image onto the first.
  *
  * This function takes two images, img1 and img2, represented as ILuint IDs. It overlays img2 onto img1,
  * replacing pixels in img1 with corresponding non-white pixels from img2. The resulting merged image is
- * returned as a new ILuint ID.
+ * returned as a new ILuint ID in the format of img1 (IL_RGB, IL_BGR or IL_RGBA); img2 is converted to
+ * that format on a copy if needed. The pixel loop runs in compositeImages().
  *
  * @param img1_id The ILuint ID of the baseline image.
  * @param img2_id The ILuint ID of the mask image.
@@ -433,6 +606,21 @@ int deleteImgTextures(std::vector<ILuint> &);
  */
 int mergeImages(ILuint, ILuint, ILuint &);
 
+/**
+ * @brief Compares an image against a reference image with a per-pixel tolerance.
+ *
+ * The per-channel absolute difference is computed with OpenCV's vectorized routines and a pixel
+ * fails if any of its channels differs by more than the tolerance.
+ *
+ * @param frame_mat Image to check.
+ * @param ref_mat Reference image, with the same size and type as frame_mat.
+ * @param tolerance Largest allowed per-channel difference.
+ * @param[out] r_heatmap_mat Reference to the color map of the per-pixel differences.
+ *
+ * @return Number of pixels outside the tolerance, -1 if the images cannot be compared.
+ */
+int diffImages(const cv::Mat &, const cv::Mat &, int, cv::Mat &);
+
 /**
  * @brief Calculates an interpolated value using bilinear interpolation on a 2D grid.
  *
@@ -467,6 +655,19 @@ float bilinearInterpolation(std::array<std::array<float, 6>, 4>, int, int, int,
  */
 float bilinearInterpolationFull(std::array<std::array<float, 6>, 4>, int, int, int, int);
 
+/**
+ * @brief Interpolates the wall width, height and shear of every grid cell in one pass.
+ *
+ * Gives the same values as calling bilinearInterpolationFull() for parameters 2 to 5 of every
+ * cell. The column weights are computed once and the inner loop over columns runs on contiguous
+ * arrays so the compiler can vectorize it.
+ *
+ * @param ctrl_point_params 4x6 array of control point parameters (x, y, width, height, shear x, shear y).
+ * @param grid_size Number of cells along one axis in the grid.
+ * @param[out] r_param_field Reference to the parameter field, resized to grid_size * grid_size cells.
+ */
+void computeWallParamField(const std::array<std::array<float, 6>, 4> &, int, WallParamField &);
+
 /**
  * @brief Creates a vector of points representing a quadrilateral with shear.
  *
@@ -486,6 +687,19 @@ float bilinearInterpolationFull(std::array<std::array<float, 6>, 4>, int, int, i
  */
 std::vector<cv::Point2f> computeQuadVertices(float, float, float, float, float, float);
 
+/**
+ * @brief Allocation-free version of computeQuadVertices() writing into caller-provided storage.
+ *
+ * @param x0 The x-coordinate of the top-left corner of the quadrilateral in NDC.
+ * @param y0 The y-coordinate of the top-left corner of the quadrilateral in NDC.
+ * @param width The width of the quadrilateral in NDC.
+ * @param height The height of the quadrilateral in NDC.
+ * @param shear_x The amount of horizontal shear to apply to the quadrilateral.
+ * @param shear_y The amount of vertical shear to apply to the quadrilateral.
+ * @param[out] p_xy_out Pointer to 8 floats receiving the x, y of the 4 corners in the same order.
+ */
+void computeQuadVertices(float, float, float, float, float, float, float *);
+
 /**
  * @brief Computes the global homography matrix based on overall control point parameters.
  *
@@ -498,19 +712,22 @@ std::vector<cv::Point2f> computeQuadVertices(float, float, float, float, float,
  * The vertices for the entire projected image are calculated based on the dimensions that enclose
  * all control points (i.e., boundary dimensions in the control point plane).
  *
- * @note This function utilizes the OpenCV library to compute the homography matrix.
+ * @note The homography is solved exactly from the 4 point pairs with solveHomography4Point()
+ *       (double precision internally) rather than the general cv::findHomography() estimator.
  *
- * @param r_hom_mat Reference to the cv::Mat object where the computed homography matrix will be stored.
+ * @param[out] r_hom_mat Reference to the cv::Mat where the computed 3x3 CV_32F homography matrix will be stored.
+ *                       Left unchanged if the control points are degenerate.
  * @param ctrl_point_params A 4x6 array containing control point parameters (x, y, width, height, shear x, shear y).
+ *
+ * @return 0 on successful execution, -1 if the control points do not form a convex quad.
  */
-void computeHomography(cv::Mat &, std::array<std::array<float, 6>, 4>);
+int computeHomography(cv::Mat &, std::array<std::array<float, 6>, 4>);
 
 /**
  * @brief Computes the perspective warp of a given set of quadrilateral vertices using a homography matrix.
  *
  * This function takes a set of quadrilateral vertices and applies a projective transformation to each vertex.
- * The transformation is governed by a given homography matrix. Before the warp, an optional translation is
- * applied to each vertex.
+ * The transformation is governed by a given homography matrix.
  *
  * @param quad_vertices_vec A vector containing the original Cartesian coordinates of the quadrilateral's vertices.
  *                          The vertices are processed in-place.
@@ -519,34 +736,83 @@ void computeHomography(cv::Mat &, std::array<std::array<float, 6>, 4>);
  *                  transformation on each vertex.
  *
  * @details
- * 1. Each vertex undergoes a translation operation defined by `x_translate` and `y_translate`.
- *
- * 2. The function converts the translated vertices to homogeneous coordinates, which allows for a unified
- *    representation that can undergo linear transformations including projective warps.
- *
- * 3. The homography matrix `r_hom_mat` is then applied to these homogeneous coordinates to produce the
- *    new coordinates of each vertex in the warped perspective.
- *
- * 4. Finally, the function converts these new homogeneous coordinates back to Cartesian coordinates.
- *
- * @note: Homogeneous Coordinates: are a mathematical trick used to simplify
- *        complex transformations like translation, rotation, and shearing.
- *        Cartesian coordinates (x, y) are converted to [x, y, 1] for the
- *        transformation. The third value (ptMat.at<float>(2)) may change
- *        post-transformation so we divide the new x and y by this value
- *        (ptMat /= ptMat.at<float>(2)) to get back to cartisian x, y coordinates.
+ * The homography is copied once into a fixed size Homography and the vertices are warped as one
+ * batch with transformPoints(). Each vertex is converted to homogeneous coordinates [x, y, 1],
+ * multiplied by the homography and divided by the resulting w to get back to Cartesian x, y.
+ * The homography may be CV_32F or CV_64F and is not modified.
  *
  * @return std::vector<cv::Point2f> A vector containing the new Cartesian coordinates of the warped vertices.
  */
 std::vector<cv::Point2f> computePerspectiveWarp(std::vector<cv::Point2f>, cv::Mat &);
 
+/**
+ * @brief Computes the warped vertices of every wall in the maze grid for one calibration.
+ *
+ * This bakes the per-wall quad and perspective warp computations into a flat array that can be
+ * uploaded to a vertex buffer once and reused for every frame. The per-wall parameters are read
+ * from a precomputed WallParamField.
+ *
+ * @details
+ * - WALL_GEOMETRY_SIZE floats are appended per wall, walls ordered by grid row then grid column,
+ *   for the grid size of the parameter field.
+ * - Each wall is stored as the x, y (NDC) of its corners in the top-left, top-right, bottom-right,
+ *   bottom-left order of computeQuadVertices(), so it can be drawn as a 4 vertex GL_TRIANGLE_FAN.
+ * - The corners are written straight into r_vertex_vec and warped in one transformPoints() pass,
+ *   so the only allocation is growing the vector.
+ *
+ * @param param_field Wall parameters of every grid cell, see computeWallParamField().
+ * @param hom_mat Homography matrix used to warp the wall vertices.
+ * @param[out] r_vertex_vec Reference to the vector the wall vertices are appended to.
+ */
+void computeWallVertices(const WallParamField &, const cv::Mat &, std::vector<float> &);
+
 /**
  * @brief Used to reset control point parameter list.
  *
+ * The default wall width, height and left/right wall offset scale with the wall spacing of the
+ * maze size, so they match CTRL_POINT_PARAMS for MAZE_SIZE.
+ *
  * @param r_ctrl_point_params Reference to the 4x6 array of control point parameters.
  * @param mode_cal_ind Index of the active calibration mode.
+ * @param grid_size Number of rows and columns in the maze.
+ */
+void updateCalParams(std::array<std::array<float, 6>, 4> &, int, int);
+
+/**
+ * @brief Checks a maze size is within [MIN_MAZE_SIZE, MAX_MAZE_SIZE].
+ *
+ * @param grid_size Number of rows and columns in the maze.
+ *
+ * @return 0 if the size is supported, -1 otherwise.
+ */
+int checkMazeSize(int);
+
+/**
+ * @brief Gets the index of a wall in a flat image map.
+ *
+ * The flat map is laid out like IMG_PROJ_MAP, i.e. [projector][chamber row][chamber column][calibration mode],
+ * with grid_size rows and columns.
+ *
+ * @param proj_i Projector index.
+ * @param wall_row_i Chamber row index, 0 is the top row.
+ * @param wall_col_i Chamber column index, 0 is the left column.
+ * @param cal_i Calibration mode index.
+ * @param grid_size Number of rows and columns in the maze.
+ *
+ * @return Index into the flat image map.
+ */
+int getImgProjMapInd(int, int, int, int, int);
+
+/**
+ * @brief Fills a flat image map for a maze size with the default image indices.
+ *
+ * IMG_PROJ_MAP is copied when grid_size is MAZE_SIZE, other sizes start blank (image 0).
+ *
+ * @param grid_size Number of rows and columns in the maze.
+ * @param[out] r_img_proj_map_vec Reference to the flat image map, resized to
+ *                                N_IMG_PROJ_MAP_PROJ * grid_size * grid_size * N_CAL_MODES entries.
  */
-void updateCalParams(std::array<std::array<float, 6>, 4> &, int);
+void initImgProjMap(int, std::vector<int> &);
 
 /**
  * @brief Prints the control point parameters to the ROS log.
@@ -558,6 +824,7 @@ void dbLogCtrlPointParams(std::array<std::array<float, 6>, 4>);
 /**
  * @brief Function to store quadrilateral parameters for debugging.
  *
+ * @param grid_size Number of rows and columns in the maze, the stored values are reset if it changes.
  * @param grid_row_i Grid row index.
  * @param grid_col_i Grid column index.
  * @param quad_width Width of the quad.
@@ -569,7 +836,7 @@ void dbLogCtrlPointParams(std::array<std::array<float, 6>, 4>);
  * @param quad_vertices_raw Vector of unwarped quad vertices.
  * @param quad_vertices_warped Vector of warped quad vertices.
  */
-void dbStoreQuadParams(float, float, float, float, float, float, float, float,
+void dbStoreQuadParams(int, float, float, float, float, float, float, float, float,
                        const std::vector<cv::Point2f> &quad_vertices_raw,
                        const std::vector<cv::Point2f> &quad_vertices_warped);
 
@@ -0,0 +1,74 @@
+// ########################################################################################################
+
+// ========================================= projection_watch.h =========================================
+
+// ########################################################################################################
+
+#ifndef _PROJECTION_WATCH_H
+#define _PROJECTION_WATCH_H
+
+// ================================================== INCLUDE ==================================================
+
+// ROS for logging
+#include <ros/console.h>
+
+// Standard Library for various utilities
+#include <string>
+
+// ================================================== VARIABLES ==================================================
+
+/**
+ * @brief Struct for a watch on the files of one directory.
+ *
+ * Uses inotify on Linux and a change notification handle on Windows. Files ending in ".tmp" are
+ * ignored so a write through a temporary file and a rename only reports the rename.
+ */
+struct DirWatcher
+{
+    std::string dir_path;     // Watched directory
+    int fd = -1;              // inotify descriptor (Linux)
+    void *p_handle = nullptr; // Change notification handle (Windows)
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Starts watching a directory for files being written, renamed into it or deleted.
+ *
+ * @param dir_path Path of the directory.
+ * @param[out] r_watcher Reference to the watcher, left closed on failure.
+ *
+ * @return 0 on successful execution, -1 on failure.
+ */
+int openDirWatcher(const std::string &, DirWatcher &);
+
+/**
+ * @brief Blocks until a file of the watched directory changes or the timeout expires.
+ *
+ * Every change pending when it returns is consumed, so a burst of changes reports once per call.
+ *
+ * @param r_watcher Reference to an open watcher.
+ * @param timeout_ms Longest time to block in milliseconds.
+ *
+ * @return 1 if a file changed, 0 on timeout, -1 on failure.
+ */
+int waitDirWatcher(DirWatcher &, int);
+
+/**
+ * @brief Stops watching a directory. Safe to call on a closed watcher.
+ *
+ * @param[out] r_watcher Reference to the watcher to close.
+ */
+void closeDirWatcher(DirWatcher &);
+
+/**
+ * @brief Gets the last modification time of a file.
+ *
+ * @param file_path Path of the file.
+ * @param[out] r_mod_time Reference to the modification time in seconds since the epoch.
+ *
+ * @return 0 on successful execution, -1 if the file does not exist.
+ */
+int getFileModTime(const std::string &, long long &);
+
+#endif
@@ -0,0 +1,762 @@
+// ##########################################################################################################
+
+// ======================================== projection_benchmark.cpp ========================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_benchmark.h"
+
+// ================================================== ALLOCATION COUNTING ==================================================
+
+// Replacements of the global allocation functions that count every operator new call.
+// Only allocations made through operator new are seen; cv::Mat buffers (cv::fastMalloc) and
+// DevIL image data are allocated with malloc and are not counted.
+
+void *operator new(std::size_t size)
+{
+    nBenchAllocs.fetch_add(1, std::memory_order_relaxed);
+    void *p_mem = std::malloc(size == 0 ? 1 : size);
+    if (!p_mem)
+        throw std::bad_alloc();
+    return p_mem;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p_mem) noexcept
+{
+    std::free(p_mem);
+}
+
+void operator delete[](void *p_mem) noexcept
+{
+    std::free(p_mem);
+}
+
+// ================================================== FUNCTIONS ==================================================
+
+int parseBenchmarkArgs(int argc, char **argv)
+{
+    for (int arg_i = 1; arg_i < argc; arg_i++)
+    {
+        std::string arg_str = argv[arg_i];
+        size_t eq_pos = arg_str.find('=');
+        if (arg_str.compare(0, 2, "--") != 0 || eq_pos == std::string::npos)
+        {
+            ROS_ERROR("[BENCH] Invalid Argument: Arg[%s] Expected[--<option>=<value>]", arg_str.c_str());
+            return -1;
+        }
+        std::string key_str = arg_str.substr(2, eq_pos - 2);
+        std::string val_str = arg_str.substr(eq_pos + 1);
+
+        if (key_str == "maze_size")
+            benchMazeSize = std::atoi(val_str.c_str());
+        else if (key_str == "min_time")
+            benchMinTimeS = std::atof(val_str.c_str());
+        else if (key_str == "filter")
+            benchFilterStr = val_str;
+        else if (key_str == "tmp_dir")
+            benchTmpDirPath = val_str;
+        else if (key_str == "scaling_max")
+            benchScalingMax = std::atoi(val_str.c_str());
+        else
+        {
+            ROS_ERROR("[BENCH] Unknown Option: Option[%s]", key_str.c_str());
+            return -1;
+        }
+    }
+
+    // The interpolation divides by (grid_size - 1)
+    if (checkMazeSize(benchMazeSize) != 0 || checkMazeSize(benchScalingMax) != 0)
+        return -1;
+    if (benchMinTimeS <= 0.0)
+    {
+        ROS_ERROR("[BENCH] Minimum Time Must be Positive: Time[%0.3f]", benchMinTimeS);
+        return -1;
+    }
+    return 0;
+}
+
+int runBenchmark(const BenchmarkCase &bench_case, BenchmarkResult &r_result)
+{
+    long long n_ops = 1;
+    while (true)
+    {
+        long long n_allocs_start = nBenchAllocs.load(std::memory_order_relaxed);
+        std::chrono::steady_clock::time_point time_start = std::chrono::steady_clock::now();
+
+        if (bench_case.run_fn(n_ops) != 0)
+        {
+            ROS_ERROR("[BENCH] Benchmark Failed: Name[%s] Operations[%lld]", bench_case.name.c_str(), n_ops);
+            return -1;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_start;
+        long long n_allocs = nBenchAllocs.load(std::memory_order_relaxed) - n_allocs_start;
+        double elapsed_s = elapsed.count();
+
+        // Report the run once it is long enough
+        if (elapsed_s >= benchMinTimeS || n_ops >= BENCH_MAX_OPS)
+        {
+            r_result.n_ops = n_ops;
+            r_result.ns_per_op = elapsed_s * 1.0e9 / (double)n_ops;
+            r_result.allocs_per_op = (double)n_allocs / (double)n_ops;
+            r_result.items_per_s = bench_case.items_per_op * (double)n_ops / elapsed_s;
+            r_result.bytes_per_s = bench_case.bytes_per_op * (double)n_ops / elapsed_s;
+            return 0;
+        }
+
+        // Aim a little past the minimum time, growing at most 10x per run
+        double scale = elapsed_s > 0.0 ? 1.4 * benchMinTimeS / elapsed_s : 10.0;
+        long long n_ops_next = (long long)((double)n_ops * std::min(scale, 10.0));
+        n_ops = std::min(std::max(n_ops_next, n_ops + 1), BENCH_MAX_OPS);
+    }
+}
+
+void printBenchmarkResult(const BenchmarkCase &bench_case, const BenchmarkResult &result)
+{
+    char items_str[32] = "-";
+    char bytes_str[32] = "-";
+    if (bench_case.items_per_op > 0.0)
+        snprintf(items_str, sizeof(items_str), "%0.3fM/s", result.items_per_s / 1.0e6);
+    if (bench_case.bytes_per_op > 0.0)
+        snprintf(bytes_str, sizeof(bytes_str), "%0.1fMB/s", result.bytes_per_s / (1024.0 * 1024.0));
+
+    printf("%-32s %14.1f %12.2f %12lld %14s %14s\n",
+           bench_case.name.c_str(), result.ns_per_op, result.allocs_per_op, result.n_ops, items_str, bytes_str);
+}
+
+int loadBenchImage(std::string img_path, ILuint &r_img_id)
+{
+    std::vector<ILuint> img_id_vec;
+    if (loadImgTextures({img_path}, img_id_vec) != 0 || img_id_vec.empty())
+    {
+        ROS_ERROR("[BENCH] Failed to Load Image: File[%s]", img_path.c_str());
+        return -1;
+    }
+    r_img_id = img_id_vec[0];
+    return 0;
+}
+
+void fillCompositeBuffers(std::vector<uint8_t> &r_base_vec, std::vector<uint8_t> &r_overlay_vec, size_t n_pxl, PixelFormat format)
+{
+    int pxl_size = getPixelSize(format);
+    r_base_vec.resize(n_pxl * pxl_size);
+    r_overlay_vec.resize(n_pxl * pxl_size);
+
+    // Fixed seed so every run composites the same pixels
+    uint32_t rand_state = 12345;
+    for (size_t pxl_i = 0; pxl_i < n_pxl; pxl_i++)
+    {
+        rand_state = rand_state * 1664525u + 1013904223u;
+        bool is_keyed = (rand_state >> 28) < 10; // ~60% of the overlay is the white key, like the UI masks
+        for (int ch_i = 0; ch_i < pxl_size; ch_i++)
+        {
+            rand_state = rand_state * 1664525u + 1013904223u;
+            r_base_vec[pxl_i * pxl_size + ch_i] = (uint8_t)(rand_state >> 24);
+            rand_state = rand_state * 1664525u + 1013904223u;
+            r_overlay_vec[pxl_i * pxl_size + ch_i] = is_keyed && ch_i < 3 ? 255 : (uint8_t)(rand_state >> 24);
+        }
+    }
+}
+
+std::vector<BenchmarkCase> createBenchmarkCases(ILuint wall_img_id, ILuint mask_img_id)
+{
+    std::vector<BenchmarkCase> bench_case_vec;
+    const int maze_size = benchMazeSize;
+    const int n_cells = maze_size * maze_size;
+    const std::array<std::array<float, 6>, 4> ctrl_point_params = CTRL_POINT_PARAMS;
+
+    // Homography shared by the warp benchmarks
+    cv::Mat hom_mat;
+    computeHomography(hom_mat, ctrl_point_params);
+
+    // Interpolation of the 4 per-wall parameters over the whole grid, one call per cell and parameter
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "bilinearInterpolationFull/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells * 4;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            float sum = 0.0f;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                for (int grid_row_i = 0; grid_row_i < maze_size; grid_row_i++)
+                    for (int grid_col_i = 0; grid_col_i < maze_size; grid_col_i++)
+                        for (int param_i = 2; param_i < 6; param_i++)
+                            sum += bilinearInterpolationFull(ctrl_point_params, param_i, grid_row_i, grid_col_i, maze_size);
+            benchSink = sum;
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Same interpolation as one structure of arrays pass
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "computeWallParamField/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells * 4;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            WallParamField param_field;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                computeWallParamField(ctrl_point_params, maze_size, param_field);
+            benchSink = param_field.width_vec[0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Quad vertices of every wall in the grid
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "computeQuadVertices/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            float sum = 0.0f;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                for (int cell_i = 0; cell_i < n_cells; cell_i++)
+                {
+                    std::vector<cv::Point2f> quad_vertices_vec = computeQuadVertices((float)cell_i, 0.0f, wall_width_ndc, wall_height_ndc, 0.0f, 0.0f);
+                    sum += quad_vertices_vec[2].x;
+                }
+            benchSink = sum;
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Homography of one calibration, with the 4 point solver and with the OpenCV estimator it replaced
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "computeHomography";
+        bench_case.items_per_op = 1;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            cv::Mat hom_out_mat;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                if (computeHomography(hom_out_mat, ctrl_point_params) != 0)
+                    return -1;
+            benchSink = hom_out_mat.at<float>(0, 0);
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "computeHomography/opencv";
+        bench_case.items_per_op = 1;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            std::vector<cv::Point2f> origin_plane_vertices = computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f);
+            std::vector<cv::Point2f> target_plane_vertices;
+            for (int cp_i = 0; cp_i < 4; cp_i++)
+                target_plane_vertices.push_back(cv::Point2f(ctrl_point_params[cp_i][0], ctrl_point_params[cp_i][1]));
+
+            cv::Mat hom_out_mat;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                hom_out_mat = cv::findHomography(origin_plane_vertices, target_plane_vertices);
+            benchSink = (float)hom_out_mat.at<double>(0, 0);
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Perspective warp of every wall quad in the grid
+    {
+        BenchmarkCase bench_case;
+        bench_case.name = "computePerspectiveWarp/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            cv::Mat hom_warp_mat = hom_mat.clone();
+            std::vector<cv::Point2f> quad_vertices_vec = computeQuadVertices(0.0f, 0.0f, wall_width_ndc, wall_height_ndc, 0.0f, 0.0f);
+            float sum = 0.0f;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                for (int cell_i = 0; cell_i < n_cells; cell_i++)
+                    sum += computePerspectiveWarp(quad_vertices_vec, hom_warp_mat)[0].x;
+            benchSink = sum;
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Batch warp of every wall corner in the grid into preallocated storage
+    {
+        Homography hom;
+        homographyFromMat(hom_mat, hom);
+
+        BenchmarkCase bench_case;
+        bench_case.name = "transformPoints/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells;
+        bench_case.bytes_per_op = (double)n_cells * WALL_GEOMETRY_SIZE * sizeof(float) * 2;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            std::vector<float> xy_in_vec(n_cells * WALL_GEOMETRY_SIZE);
+            for (int cell_i = 0; cell_i < n_cells; cell_i++)
+                computeQuadVertices((float)cell_i, 0.0f, wall_width_ndc, wall_height_ndc, 0.0f, 0.0f, &xy_in_vec[cell_i * WALL_GEOMETRY_SIZE]);
+            std::vector<float> xy_out_vec(xy_in_vec.size());
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                transformPoints(hom, xy_in_vec.data(), xy_out_vec.data(), n_cells * 4);
+            benchSink = xy_out_vec[0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Full geometry bake of one calibration from its parameter field
+    {
+        WallParamField param_field;
+        computeWallParamField(ctrl_point_params, maze_size, param_field);
+
+        BenchmarkCase bench_case;
+        bench_case.name = "computeWallVertices/" + std::to_string(maze_size);
+        bench_case.items_per_op = n_cells;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            std::vector<float> vertex_vec;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                vertex_vec.clear();
+                computeWallVertices(param_field, hom_mat, vertex_vec);
+            }
+            benchSink = vertex_vec[0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Overlay of a mask image onto a wall image
+    {
+        ilBindImage(wall_img_id);
+        int width = ilGetInteger(IL_IMAGE_WIDTH);
+        int height = ilGetInteger(IL_IMAGE_HEIGHT);
+
+        BenchmarkCase bench_case;
+        bench_case.name = "mergeImages";
+        bench_case.items_per_op = 1;
+        bench_case.bytes_per_op = (double)width * height * ilGetInteger(IL_IMAGE_BPP) * 3;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                ILuint img_merge_id = 0;
+                if (mergeImages(wall_img_id, mask_img_id, img_merge_id) != 0)
+                    return -1;
+                ilDeleteImages(1, &img_merge_id);
+            }
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Compositing kernels on wall sized buffers
+    {
+        const size_t n_pxl = WALL_WIDTH_PXL * WALL_HEIGHT_PXL;
+        struct CompositeConfig
+        {
+            const char *name;
+            PixelFormat format;
+            CompositeMode mode;
+        };
+        const CompositeConfig config_arr[] = {
+            {"rgb_key", PIXEL_RGB, COMPOSITE_COLOR_KEY},
+            {"rgba_key", PIXEL_RGBA, COMPOSITE_COLOR_KEY},
+            {"rgba_alpha", PIXEL_RGBA, COMPOSITE_ALPHA},
+        };
+
+        for (const CompositeConfig &config : config_arr)
+        {
+            // Buffers are shared by the kernels of one configuration
+            auto p_base_vec = std::make_shared<std::vector<uint8_t>>();
+            auto p_overlay_vec = std::make_shared<std::vector<uint8_t>>();
+            fillCompositeBuffers(*p_base_vec, *p_overlay_vec, n_pxl, config.format);
+            auto p_out_vec = std::make_shared<std::vector<uint8_t>>(p_base_vec->size());
+
+            for (int kernel_i = 0; kernel_i < N_COMPOSITE_KERNELS; kernel_i++)
+            {
+                CompositeKernel kernel = (CompositeKernel)kernel_i;
+                if (!isCompositeKernelSupported(kernel))
+                    continue;
+
+                BenchmarkCase bench_case;
+                bench_case.name = std::string("compositeImages/") + config.name + "/" + getCompositeKernelName(kernel);
+                bench_case.items_per_op = 1;
+                bench_case.bytes_per_op = (double)p_base_vec->size() * 3;
+                bench_case.run_fn = [=](long long n_ops)
+                {
+                    for (long long op_i = 0; op_i < n_ops; op_i++)
+                        if (compositeImagesWith(kernel, p_base_vec->data(), p_overlay_vec->data(), p_out_vec->data(),
+                                                n_pxl, config.format, config.mode, COMPOSITE_KEY_WHITE) != 0)
+                            return -1;
+                    benchSink = (*p_out_vec)[0];
+                    return 0;
+                };
+                bench_case_vec.push_back(bench_case);
+            }
+        }
+    }
+
+    // Calibration XML round trip
+    {
+        std::string save_path = benchTmpDirPath + "/bench_cfg.xml";
+        std::ifstream cfg_file(bench_cfg_path, std::ios::binary | std::ios::ate);
+        double cfg_bytes = cfg_file ? (double)cfg_file.tellg() : 0.0;
+
+        BenchmarkCase bench_case;
+        bench_case.name = "loadCoordinatesXML";
+        bench_case.items_per_op = 1;
+        bench_case.bytes_per_op = cfg_bytes;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            cv::Mat hom_load_mat = cv::Mat::eye(3, 3, CV_32F);
+            std::array<std::array<float, 6>, 4> ctrl_point_params_load;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                if (loadCoordinatesXML(hom_load_mat, ctrl_point_params_load, bench_cfg_path, 0) != 0)
+                    return -1;
+            benchSink = ctrl_point_params_load[0][0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+
+        bench_case.name = "saveCoordinatesXML";
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                if (saveCoordinatesXML(hom_mat, ctrl_point_params, save_path) != 0)
+                    return -1;
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Display startup calibration load, XML files against the memory-mapped bundle
+    {
+        std::string bundle_path = benchTmpDirPath + "/bench_cfg.bin";
+        bool is_bundle_ok = convertCalibrationXMLToBundle(CONFIG_DIR_PATH, bundle_path) == 0;
+        if (!is_bundle_ok)
+            ROS_ERROR("[BENCH] Failed to Build the Calibration Bundle: File[%s]", bundle_path.c_str());
+
+        BenchmarkCase bench_case;
+        bench_case.name = "loadCalibrationParams/xml";
+        bench_case.items_per_op = N_CAL_MODES;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            std::array<CalibrationParams, N_CAL_MODES> cal_params_arr;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+                if (loadCalibrationParams(1, CONFIG_DIR_PATH, benchMazeSize, cal_params_arr) != 0)
+                    return -1;
+            benchSink = cal_params_arr[0].ctrl_point_params[0][0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+
+        bench_case.name = "loadCalibrationParams/bundle";
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            if (!is_bundle_ok)
+                return -1;
+            std::array<CalibrationParams, N_CAL_MODES> cal_params_arr;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                MappedCalibrationBundle bundle;
+                int status = openCalibrationBundle(bundle_path, bundle) == 0 ? loadCalibrationParams(bundle, 1, benchMazeSize, cal_params_arr) : -1;
+                closeCalibrationBundle(bundle);
+                if (status != 0)
+                    return -1;
+            }
+            benchSink = cal_params_arr[0].ctrl_point_params[0][0];
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    // Image file decode into DevIL
+    {
+        ilBindImage(wall_img_id);
+        int width = ilGetInteger(IL_IMAGE_WIDTH);
+        int height = ilGetInteger(IL_IMAGE_HEIGHT);
+
+        BenchmarkCase bench_case;
+        bench_case.name = "loadImgTextures";
+        bench_case.items_per_op = 1;
+        bench_case.bytes_per_op = (double)width * height * 3;
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            std::vector<std::string> img_path_vec = {bench_wall_img_path};
+            std::vector<ILuint> img_id_vec;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                if (loadImgTextures(img_path_vec, img_id_vec) != 0)
+                    return -1;
+                deleteImgTextures(img_id_vec);
+            }
+            return 0;
+        };
+        bench_case_vec.push_back(bench_case);
+    }
+
+    return bench_case_vec;
+}
+
+int setupBenchFrameContext(HeadlessContextEGL &r_context, RendererGL &r_renderer, GLuint &r_fbo_id, GLuint &r_fbo_texture_id,
+                           GLuint &r_texture_array_id, ILuint wall_img_id)
+{
+    // Create the context and load the OpenGL functions through EGL
+    if (createHeadlessContext(r_context) != 0 || makeHeadlessContextCurrent(r_context) != 0)
+        return -1;
+    if (!gladLoadGLLoader((GLADloadproc)getHeadlessProcAddress))
+    {
+        ROS_ERROR("[BENCH] Failed to Load OpenGL Functions");
+        return -1;
+    }
+    if (initRenderer(r_renderer) != 0)
+        return -1;
+
+    // FBO at projector resolution, as the display node renders into
+    glGenFramebuffers(1, &r_fbo_id);
+    glBindFramebuffer(GL_FRAMEBUFFER, r_fbo_id);
+    glGenTextures(1, &r_fbo_texture_id);
+    glBindTexture(GL_TEXTURE_2D, r_fbo_texture_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, r_fbo_texture_id, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        ROS_ERROR("[BENCH] Framebuffer is Not Complete");
+        return -1;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Every wall samples the same layer, the draw cost does not depend on which image it shows
+    if (loadGLTextureArray({wall_img_id}, r_texture_array_id) != 0)
+        return -1;
+
+    return glGetError() == GL_NO_ERROR ? 0 : -1;
+}
+
+void deleteBenchFrameContext(HeadlessContextEGL &r_context, RendererGL &r_renderer, GLuint &r_fbo_id, GLuint &r_fbo_texture_id,
+                             GLuint &r_texture_array_id)
+{
+    // The GL objects only exist once the renderer was initialized and the FBO created
+    if (r_fbo_id != 0)
+    {
+        deleteRenderer(r_renderer);
+        glDeleteFramebuffers(1, &r_fbo_id);
+        glDeleteTextures(1, &r_fbo_texture_id);
+        glDeleteTextures(1, &r_texture_array_id);
+    }
+    r_fbo_id = 0;
+    r_fbo_texture_id = 0;
+    r_texture_array_id = 0;
+    deleteHeadlessContext(r_context);
+}
+
+int runScalingBenchmarks(ILuint wall_img_id)
+{
+    // Maze sizes to run
+    std::vector<int> grid_size_vec;
+    for (int grid_size = MAZE_SIZE; grid_size <= benchScalingMax; grid_size += 2)
+        grid_size_vec.push_back(grid_size);
+    if (grid_size_vec.empty() || grid_size_vec.back() != benchScalingMax)
+        grid_size_vec.push_back(benchScalingMax);
+
+    // Default control points of every calibration mode for each maze size
+    std::vector<std::array<std::array<std::array<float, 6>, 4>, N_CAL_MODES>> ctrl_point_params_vec(grid_size_vec.size());
+    for (size_t size_i = 0; size_i < grid_size_vec.size(); size_i++)
+        for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+            updateCalParams(ctrl_point_params_vec[size_i][cal_i], cal_i, grid_size_vec[size_i]);
+
+    // _______________ GEOMETRY REBAKE _______________
+
+    printf("\n%-32s %8s %8s %14s %12s\n", "Scaling (calibration change)", "Cells", "Walls", "us/rebake", "allocs/op");
+    printf("%s\n", std::string(78, '-').c_str());
+
+    int status = 0;
+    for (size_t size_i = 0; size_i < grid_size_vec.size(); size_i++)
+    {
+        int grid_size = grid_size_vec[size_i];
+        const std::array<std::array<std::array<float, 6>, 4>, N_CAL_MODES> ctrl_point_params_arr = ctrl_point_params_vec[size_i];
+
+        BenchmarkCase bench_case;
+        bench_case.name = "wallGeometry/" + std::to_string(grid_size);
+        bench_case.items_per_op = N_CAL_MODES * grid_size * grid_size;
+        if (!benchFilterStr.empty() && bench_case.name.find(benchFilterStr) == std::string::npos)
+            continue;
+
+        bench_case.run_fn = [=](long long n_ops)
+        {
+            // Buffers are reused between rebakes like the nodes' calibration state
+            std::array<CalibrationParams, N_CAL_MODES> cal_params_arr;
+            std::vector<float> vertex_vec;
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                vertex_vec.clear();
+                for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+                {
+                    CalibrationParams &r_cal_params = cal_params_arr[cal_i];
+                    if (computeHomography(r_cal_params.hom_mat, ctrl_point_params_arr[cal_i]) != 0)
+                        return -1;
+                    computeWallParamField(ctrl_point_params_arr[cal_i], grid_size, r_cal_params.param_field);
+                    computeWallVertices(r_cal_params.param_field, r_cal_params.hom_mat, vertex_vec);
+                }
+            }
+            benchSink = vertex_vec[0];
+            return 0;
+        };
+
+        BenchmarkResult result;
+        if (runBenchmark(bench_case, result) != 0)
+        {
+            status = -1;
+            continue;
+        }
+        printf("%-32s %8d %8.0f %14.2f %12.2f\n",
+               bench_case.name.c_str(), grid_size * grid_size, bench_case.items_per_op,
+               result.ns_per_op / 1.0e3, result.allocs_per_op);
+    }
+
+    // _______________ HEADLESS FRAME _______________
+
+    if (!IS_HEADLESS_EGL)
+    {
+        printf("\nFrame scaling skipped: needs a build with -DHEADLESS_EGL=ON, or run\n"
+               "projection_display_node _headless:=true _maze_size:=<n> _frame_metrics:=true\n");
+        return status;
+    }
+
+    HeadlessContextEGL context;
+    RendererGL renderer;
+    GLuint fbo_id = 0, fbo_texture_id = 0, texture_array_id = 0;
+    if (setupBenchFrameContext(context, renderer, fbo_id, fbo_texture_id, texture_array_id, wall_img_id) != 0)
+    {
+        ROS_ERROR("[BENCH] Failed to Set Up the Headless Frame Context");
+        deleteBenchFrameContext(context, renderer, fbo_id, fbo_texture_id, texture_array_id);
+        return -1;
+    }
+
+    printf("\nRenderer[%s] Frame[%dx%d]\n", glGetString(GL_RENDERER), PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL);
+    printf("%-32s %8s %8s %14s %12s %14s\n", "Scaling (frame)", "Cells", "Walls", "us/frame", "allocs/op", "60Hz Frame");
+    printf("%s\n", std::string(93, '-').c_str());
+
+    for (size_t size_i = 0; size_i < grid_size_vec.size(); size_i++)
+    {
+        int grid_size = grid_size_vec[size_i];
+        int n_walls = N_CAL_MODES * grid_size * grid_size;
+
+        BenchmarkCase bench_case;
+        bench_case.name = "wallFrame/" + std::to_string(grid_size);
+        bench_case.items_per_op = n_walls;
+        if (!benchFilterStr.empty() && bench_case.name.find(benchFilterStr) == std::string::npos)
+            continue;
+
+        // Bake and upload the walls of every calibration mode once, as the display node does on a calibration change
+        std::vector<float> vertex_vec;
+        for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+        {
+            CalibrationParams cal_params;
+            computeHomography(cal_params.hom_mat, ctrl_point_params_vec[size_i][cal_i]);
+            computeWallParamField(ctrl_point_params_vec[size_i][cal_i], grid_size, cal_params.param_field);
+            computeWallVertices(cal_params.param_field, cal_params.hom_mat, vertex_vec);
+        }
+        std::vector<GLint> layer_vec(n_walls, 0);
+        GLuint vbo_id = 0, layer_vbo_id = 0, vao_id = 0;
+        glGenBuffers(1, &vbo_id);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_id);
+        glBufferData(GL_ARRAY_BUFFER, vertex_vec.size() * sizeof(GLfloat), vertex_vec.data(), GL_STATIC_DRAW);
+        glGenBuffers(1, &layer_vbo_id);
+        glBindBuffer(GL_ARRAY_BUFFER, layer_vbo_id);
+        glBufferData(GL_ARRAY_BUFFER, layer_vec.size() * sizeof(GLint), layer_vec.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // One operation is one frame: clear, draw every wall, and wait for the GPU to finish
+        bench_case.run_fn = [&](long long n_ops)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo_id);
+            glViewport(0, 0, PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL);
+            for (long long op_i = 0; op_i < n_ops; op_i++)
+            {
+                glClear(GL_COLOR_BUFFER_BIT);
+                drawWallsInstanced(renderer, vao_id, n_walls, texture_array_id);
+                glFinish();
+            }
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return glGetError() == GL_NO_ERROR ? 0 : -1;
+        };
+
+        BenchmarkResult result;
+        if (createWallVertexArray(vbo_id, layer_vbo_id, vao_id) != 0 || runBenchmark(bench_case, result) != 0)
+            status = -1;
+        else
+            printf("%-32s %8d %8d %14.2f %12.2f %13.1f%%\n",
+                   bench_case.name.c_str(), grid_size * grid_size, n_walls,
+                   result.ns_per_op / 1.0e3, result.allocs_per_op, 100.0 * result.ns_per_op / BENCH_FRAME_BUDGET_NS);
+
+        glDeleteVertexArrays(1, &vao_id);
+        glDeleteBuffers(1, &vbo_id);
+        glDeleteBuffers(1, &layer_vbo_id);
+    }
+
+    deleteBenchFrameContext(context, renderer, fbo_id, fbo_texture_id, texture_array_id);
+    return status;
+}
+
+// ================================================== MAIN ==================================================
+
+int main(int argc, char **argv)
+{
+    if (parseBenchmarkArgs(argc, argv) != 0)
+        return -1;
+
+    // Only keep warnings and errors so per-call logging does not end up in the timings
+    if (ros::console::set_logger_level(ROSCONSOLE_DEFAULT_NAME, ros::console::levels::Warn))
+        ros::console::notifyLoggerLevelsChanged();
+
+    // Initialize DevIL library
+    ilInit();
+    if (checkErrorDevIL(__LINE__, __FILE__, "Initializing DevIL") != 0)
+        return -1;
+
+    // Kernels are checked against the scalar one by test_projection_utils
+    printf("Composite Kernel[%s]\n", getCompositeKernelName(getCompositeKernel()));
+
+    // Load the images used by the mergeImages benchmark
+    ILuint wall_img_id = 0;
+    ILuint mask_img_id = 0;
+    if (loadBenchImage(bench_wall_img_path, wall_img_id) != 0 ||
+        loadBenchImage(bench_mask_img_path, mask_img_id) != 0)
+        return -1;
+
+    std::vector<BenchmarkCase> bench_case_vec = createBenchmarkCases(wall_img_id, mask_img_id);
+
+    printf("Maze Size[%d] Minimum Time[%0.2fs]\n", benchMazeSize, benchMinTimeS);
+    printf("%-32s %14s %12s %12s %14s %14s\n", "Benchmark", "ns/op", "allocs/op", "Iterations", "Items", "Bytes");
+    printf("%s\n", std::string(103, '-').c_str());
+
+    int status = 0;
+    for (const BenchmarkCase &bench_case : bench_case_vec)
+    {
+        if (!benchFilterStr.empty() && bench_case.name.find(benchFilterStr) == std::string::npos)
+            continue;
+
+        BenchmarkResult result;
+        if (runBenchmark(bench_case, result) != 0)
+        {
+            status = -1;
+            continue;
+        }
+        printBenchmarkResult(bench_case, result);
+    }
+
+    // Geometry and frame cost against maze size
+    if (runScalingBenchmarks(wall_img_id) != 0)
+        status = -1;
+
+    ilDeleteImages(1, &wall_img_id);
+    ilDeleteImages(1, &mask_img_id);
+    return status;
+}
@@ -0,0 +1,239 @@
+// ##########################################################################################################
+
+// ========================================= projection_bundle.cpp =========================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_bundle.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Memory mapping and atomic rename are platform specific
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ================================================== FUNCTIONS ==================================================
+
+uint32_t computeCRC32(const void *p_data, size_t n_bytes)
+{
+    // Table for the reflected polynomial 0xEDB88320, built on first use
+    static uint32_t crc_table[256];
+    static bool is_table_init = false;
+    if (!is_table_init)
+    {
+        for (uint32_t byte_i = 0; byte_i < 256; byte_i++)
+        {
+            uint32_t crc = byte_i;
+            for (int bit_i = 0; bit_i < 8; bit_i++)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            crc_table[byte_i] = crc;
+        }
+        is_table_init = true;
+    }
+
+    const uint8_t *p_byte = static_cast<const uint8_t *>(p_data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t byte_i = 0; byte_i < n_bytes; byte_i++)
+        crc = crc_table[(crc ^ p_byte[byte_i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Maps a whole file read-only.
+ */
+static int mapFileReadOnly(const std::string &file_path, MappedCalibrationBundle &r_bundle)
+{
+#ifdef _WIN32
+    // Share delete access so the writer can rename a new bundle over this one
+    HANDLE file_handle = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                     NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return -1;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file_handle);
+        return -1;
+    }
+    HANDLE map_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (map_handle == NULL)
+    {
+        CloseHandle(file_handle);
+        return -1;
+    }
+    void *p_map = MapViewOfFile(map_handle, FILE_MAP_READ, 0, 0, 0);
+    if (p_map == NULL)
+    {
+        CloseHandle(map_handle);
+        CloseHandle(file_handle);
+        return -1;
+    }
+    r_bundle.p_file_handle = file_handle;
+    r_bundle.p_map_handle = map_handle;
+    r_bundle.file_size = (size_t)file_size.QuadPart;
+#else
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return -1;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        close(fd);
+        return -1;
+    }
+    void *p_map = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file referenced
+    if (p_map == MAP_FAILED)
+        return -1;
+    r_bundle.file_size = (size_t)file_stat.st_size;
+#endif
+    r_bundle.p_map = p_map;
+    return 0;
+}
+
+int openCalibrationBundle(const std::string &bundle_path, MappedCalibrationBundle &r_bundle)
+{
+    closeCalibrationBundle(r_bundle);
+    if (mapFileReadOnly(bundle_path, r_bundle) != 0)
+    {
+        ROS_ERROR("[BUNDLE] Could Not Map Calibration Bundle: File[%s]", bundle_path.c_str());
+        return -1;
+    }
+
+    // Validate the header before trusting any size in it
+    const CalibrationBundleHeader *p_header = static_cast<const CalibrationBundleHeader *>(r_bundle.p_map);
+    const char *err_str = nullptr;
+    if (r_bundle.file_size < sizeof(CalibrationBundleHeader))
+        err_str = "File Too Small";
+    else if (std::memcmp(p_header->magic, CAL_BUNDLE_MAGIC, sizeof(CAL_BUNDLE_MAGIC)) != 0)
+        err_str = "Not a Calibration Bundle";
+    else if (p_header->endian_tag != CAL_BUNDLE_ENDIAN_TAG)
+        err_str = "Byte Order Mismatch";
+    else if (p_header->version != CAL_BUNDLE_VERSION)
+        err_str = "Unsupported Version";
+    else if (p_header->entry_size != sizeof(CalibrationBundleEntry))
+        err_str = "Entry Size Mismatch";
+    else if (r_bundle.file_size != sizeof(CalibrationBundleHeader) + (size_t)p_header->n_entries * sizeof(CalibrationBundleEntry))
+        err_str = "File Size Mismatch";
+    else if (computeCRC32(p_header + 1, (size_t)p_header->n_entries * sizeof(CalibrationBundleEntry)) != p_header->entries_crc)
+        err_str = "Checksum Mismatch";
+    if (err_str)
+    {
+        ROS_ERROR("[BUNDLE] Invalid Calibration Bundle: Error[%s] File[%s]", err_str, bundle_path.c_str());
+        closeCalibrationBundle(r_bundle);
+        return -1;
+    }
+
+    r_bundle.p_header = p_header;
+    r_bundle.p_entries = reinterpret_cast<const CalibrationBundleEntry *>(p_header + 1);
+    r_bundle.n_entries = p_header->n_entries;
+    return 0;
+}
+
+void closeCalibrationBundle(MappedCalibrationBundle &r_bundle)
+{
+    if (r_bundle.p_map)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(r_bundle.p_map);
+        CloseHandle((HANDLE)r_bundle.p_map_handle);
+        CloseHandle((HANDLE)r_bundle.p_file_handle);
+#else
+        munmap(r_bundle.p_map, r_bundle.file_size);
+#endif
+    }
+    r_bundle = MappedCalibrationBundle();
+}
+
+const CalibrationBundleEntry *findCalibrationBundleEntry(const MappedCalibrationBundle &bundle, int mon_ind, int cal_ind)
+{
+    // Entries are sorted, but bundles are a handful of entries so a linear scan is enough
+    for (size_t entry_i = 0; entry_i < bundle.n_entries; entry_i++)
+    {
+        const CalibrationBundleEntry &entry = bundle.p_entries[entry_i];
+        if (entry.mon_ind == mon_ind && entry.cal_ind == cal_ind)
+            return &entry;
+    }
+    return nullptr;
+}
+
+int replaceFile(const std::string &src_path, const std::string &dst_path)
+{
+#ifdef _WIN32
+    return MoveFileExA(src_path.c_str(), dst_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0 ? 0 : -1;
+#else
+    return std::rename(src_path.c_str(), dst_path.c_str()) == 0 ? 0 : -1;
+#endif
+}
+
+int writeCalibrationBundle(const std::string &bundle_path, std::vector<CalibrationBundleEntry> entry_vec)
+{
+    std::sort(entry_vec.begin(), entry_vec.end(), [](const CalibrationBundleEntry &a, const CalibrationBundleEntry &b)
+              { return a.mon_ind != b.mon_ind ? a.mon_ind < b.mon_ind : a.cal_ind < b.cal_ind; });
+    for (size_t entry_i = 1; entry_i < entry_vec.size(); entry_i++)
+    {
+        if (entry_vec[entry_i].mon_ind == entry_vec[entry_i - 1].mon_ind && entry_vec[entry_i].cal_ind == entry_vec[entry_i - 1].cal_ind)
+        {
+            ROS_ERROR("[BUNDLE] Duplicate Calibration Bundle Entry: Monitor[%d] Mode[%d]", entry_vec[entry_i].mon_ind, entry_vec[entry_i].cal_ind);
+            return -1;
+        }
+    }
+
+    CalibrationBundleHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CAL_BUNDLE_MAGIC, sizeof(CAL_BUNDLE_MAGIC));
+    header.version = CAL_BUNDLE_VERSION;
+    header.endian_tag = CAL_BUNDLE_ENDIAN_TAG;
+    header.entry_size = sizeof(CalibrationBundleEntry);
+    header.n_entries = (uint32_t)entry_vec.size();
+    header.entries_crc = computeCRC32(entry_vec.data(), entry_vec.size() * sizeof(CalibrationBundleEntry));
+
+    // Write a temporary file next to the bundle
+    std::string tmp_path = bundle_path + ".tmp";
+    FILE *p_file = std::fopen(tmp_path.c_str(), "wb");
+    if (!p_file)
+    {
+        ROS_ERROR("[BUNDLE] Could Not Create File: File[%s]", tmp_path.c_str());
+        return -1;
+    }
+    bool is_written = std::fwrite(&header, sizeof(header), 1, p_file) == 1 &&
+                      (entry_vec.empty() || std::fwrite(entry_vec.data(), sizeof(CalibrationBundleEntry), entry_vec.size(), p_file) == entry_vec.size());
+    is_written = std::fflush(p_file) == 0 && is_written;
+#ifndef _WIN32
+    is_written = fsync(fileno(p_file)) == 0 && is_written;
+#endif
+    is_written = std::fclose(p_file) == 0 && is_written;
+    if (!is_written)
+    {
+        ROS_ERROR("[BUNDLE] Could Not Write File: File[%s]", tmp_path.c_str());
+        std::remove(tmp_path.c_str());
+        return -1;
+    }
+
+    // Replace the bundle in one step
+    if (replaceFile(tmp_path, bundle_path) != 0)
+    {
+        ROS_ERROR("[BUNDLE] Could Not Replace Calibration Bundle: File[%s]", bundle_path.c_str());
+        std::remove(tmp_path.c_str());
+        return -1;
+    }
+
+    ROS_INFO("[BUNDLE] Saved Calibration Bundle: Entries[%zu] File[%s]", entry_vec.size(), bundle_path.c_str());
+    return 0;
+}
@@ -16,6 +16,10 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
     // Set the current OpenGL context to the window
     glfwMakeContextCurrent(window);
 
+    // Store the window mode to check for changes
+    int win_mon_ind_last = winMonInd;
+    bool is_fullscreen_last = isFullScreen;
+
     // _______________ ANY KEY RELEASE ACTION _______________
 
     if (action == GLFW_RELEASE)
@@ -60,28 +64,23 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
         // Save coordinates to XML
         else if (key == GLFW_KEY_ENTER)
         {
-            // Get the path to the config directory and format the save file name
-            std::string file_path = formatCoordinatesFilePathXML(winMonInd, calModeInd, CONFIG_DIR_PATH);
-
-            // Save the coordinates to the XML file
-            saveCoordinatesXML(homMat, ctrlPointParams, file_path);
+            // Queue the coordinates for the background writer, which saves the XML file and rebuilds the bundle
+            calActionFlags |= CAL_ACTION_SAVE;
         }
 
         // Load coordinates from XML
         else if (key == GLFW_KEY_L)
         {
-            // Get the path to the config directory and format the load file name
-            std::string file_path = formatCoordinatesFilePathXML(winMonInd, calModeInd, CONFIG_DIR_PATH);
-
-            // Load the coordinates from the XML file
-            loadCoordinatesXML(homMat, ctrlPointParams, file_path, 3);
+            // Load the coordinates and stream them to the display node
+            calActionFlags |= CAL_ACTION_LOAD | CAL_ACTION_UPDATE | CAL_ACTION_PUBLISH;
         }
 
         // ---------- Control Point Reset [R] ----------
 
         else if (key == GLFW_KEY_R)
         {
-            updateCalParams(ctrlPointParams, calModeInd);
+            updateCalParams(ctrlPointParams, calModeInd, mazeSize);
+            calActionFlags |= CAL_ACTION_UPDATE | CAL_ACTION_PUBLISH;
         }
 
         // ---------- Target selector keys [F1-F4] ----------
@@ -151,10 +150,12 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
             {
                 calModeInd = (calModeInd < nCalModes - 1) ? calModeInd + 1 : 0;
             }
-            // Reset a subset of control point parameters when switching calibration modes
+            // Reset a subset of control point parameters when switching calibration modes, not published
+            // so the display node keeps the saved calibration of the new mode until it is edited or loaded
             if (key == GLFW_KEY_LEFT || key == GLFW_KEY_RIGHT)
             {
-                updateCalParams(ctrlPointParams, calModeInd);
+                updateCalParams(ctrlPointParams, calModeInd, mazeSize);
+                calActionFlags |= CAL_ACTION_UPDATE;
             }
         }
 
@@ -169,7 +170,7 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
             }
             else if (key == GLFW_KEY_RIGHT)
             {
-                imgWallInd = (imgWallInd < imgWallPathVec.size() - 1) ? imgWallInd + 1 : 0;
+                imgWallInd = (imgWallInd < (int)imgWallPathVec.size() - 1) ? imgWallInd + 1 : 0;
             }
         }
 
@@ -252,22 +253,33 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
                     ctrlPointParams[cpSelectedInd][5] -= shr_inc_y; // Decrease height
                 }
             }
+
+            // Stream the edit to the display node, mode switches and resets only change what is shown here
+            if (key == GLFW_KEY_LEFT || key == GLFW_KEY_RIGHT || key == GLFW_KEY_UP || key == GLFW_KEY_DOWN)
+                calActionFlags |= CAL_ACTION_UPDATE | CAL_ACTION_PUBLISH;
         }
     }
 
     // _______________ Update _______________
 
-    // Recompute homography matrix
-    computeHomography(homMat, ctrlPointParams);
+    // Update the window monitor and mode if either changed
+    if (winMonInd != win_mon_ind_last || isFullScreen != is_fullscreen_last)
+        updateWindowMonMode(p_windowID, 0, pp_monitorIDVec, winMonInd, isFullScreen);
 
-    // Update the window monitor and mode
-    updateWindowMonMode(p_windowID, 0, pp_monitorIDVec, winMonInd, isFullScreen);
+    // Redraw the frame with the new state
+    isFrameDirty = true;
 }
 
 void callbackFrameBufferSizeGLFW(GLFWwindow *window, int width, int height)
 {
     glViewport(0, 0, width, height);
     checkErrorGL(__LINE__, __FILE__);
+    isFrameDirty = true;
+}
+
+void callbackWindowRefreshGLFW(GLFWwindow *window)
+{
+    isFrameDirty = true;
 }
 
 static void callbackErrorGLFW(int error, const char *description)
@@ -277,6 +289,10 @@ static void callbackErrorGLFW(int error, const char *description)
 
 int checkErrorGL(int line, const char *file_str, const char *msg_str)
 {
+    // Skip the synchronous check unless enabled
+    if (!isGLSyncCheck)
+        return 0;
+
     GLenum gl_err;
     while ((gl_err = glGetError()) != GL_NO_ERROR)
     {
@@ -373,157 +389,278 @@ int updateWindowMonMode(GLFWwindow *p_window_id, int win_ind, GLFWmonitor **&pp_
     return 0;
 }
 
-int drawControlPoint(float x, float y, float radius, std::vector<float> rgb_vec)
+int drawControlPoint(RendererGL &r_renderer, float x, float y, float radius, std::vector<float> rgb_vec)
 {
     const int segments = 100; // Number of segments to approximate a circle
 
-    // Begin drawing a filled circle
-    glBegin(GL_TRIANGLE_FAN);
-
-    // Set the color to green
-    glColor3f(rgb_vec[0], rgb_vec[1], rgb_vec[2]);
+    // Vertices of the filled circle: the center followed by the perimeter points (x, y, u, v)
+    GLfloat vertices[(segments + 2) * 4];
 
     // Center of the circle
-    glVertex2f(x, y);
+    vertices[0] = x;
+    vertices[1] = y;
+    vertices[2] = 0.0f;
+    vertices[3] = 0.0f;
 
-    // Calculate and draw the vertices of the circle
+    // Calculate the vertices of the circle
     for (int i = 0; i <= segments; i++)
     {
         float theta = 2.0f * 3.1415926f * float(i) / float(segments);
-        float px = x + radius * cosf(theta);
-        float py = y + (radius * PROJ_WIN_ASPECT_RATIO) * sinf(theta);
-        glVertex2f(px, py);
+        GLfloat *p_vert = &vertices[(i + 1) * 4];
+        p_vert[0] = x + radius * cosf(theta);
+        p_vert[1] = y + (radius * PROJ_WIN_ASPECT_RATIO) * sinf(theta);
+        p_vert[2] = 0.0f;
+        p_vert[3] = 0.0f;
     }
 
-    // End drawing
-    glEnd();
+    // Draw the filled circle
+    drawStreamColored(r_renderer, vertices, segments + 2, rgb_vec);
 
     // Return GL status
     return checkErrorGL(__LINE__, __FILE__);
 }
 
-int drawQuadImage(std::vector<cv::Point2f> quad_vertices_vec)
+int drawQuadImage(RendererGL &r_renderer, const float *p_quad_xy, GLuint texture_array_id, GLint base_layer, const std::array<GLint, N_OVERLAY_LAYERS> &overlay_layer_arr)
 {
-
-    // Start drawing a quadrilateral
-    glBegin(GL_QUADS);
-
-    // Set the color to white (for texture mapping)
-    /// @note: this is nececary when drawing the control points
-    glColor3f(1.0f, 1.0f, 1.0f);
-
     // Set texture and vertex coordinates for each corner
+    GLfloat vertices[16] = {
+        // Top-left corner of texture
+        p_quad_xy[0], p_quad_xy[1], 0.0f, 1.0f,
+        // Top-right corner of texture
+        p_quad_xy[2], p_quad_xy[3], 1.0f, 1.0f,
+        // Bottom-right corner of texture
+        p_quad_xy[4], p_quad_xy[5], 1.0f, 0.0f,
+        // Bottom-left corner of texture
+        p_quad_xy[6], p_quad_xy[7], 0.0f, 0.0f,
+    };
+
+    // Draw the quadrilateral
+    drawStreamLayered(r_renderer, vertices, 4, texture_array_id, base_layer, overlay_layer_arr);
 
-    // Top-left corner of texture
-    glTexCoord2f(0.0f, 1.0f);
-    glVertex2f(quad_vertices_vec[0].x, quad_vertices_vec[0].y);
-
-    // Top-right corner of texture
-    glTexCoord2f(1.0f, 1.0f);
-    glVertex2f(quad_vertices_vec[1].x, quad_vertices_vec[1].y);
+    // Check and return GL status
+    return checkErrorGL(__LINE__, __FILE__);
+}
 
-    // Bottom-right corner of texture
-    glTexCoord2f(1.0f, 0.0f);
-    glVertex2f(quad_vertices_vec[2].x, quad_vertices_vec[2].y);
+int drawWalls(RendererGL &r_renderer, const cv::Mat &hom_mat, const WallParamField &param_field, GLuint texture_array_id, GLint wall_layer, const std::array<GLint, N_OVERLAY_LAYERS> &overlay_layer_arr)
+{
+    // Overlay layers of the walls without a selected control point
+    const std::array<GLint, N_OVERLAY_LAYERS> no_overlay_layer_arr = {{-1, -1, -1}};
+
+    // Compute the warped vertices of every wall, ordered by grid row then grid column
+    const int grid_size = param_field.grid_size;
+    std::vector<float> vertex_vec;
+    computeWallVertices(param_field, hom_mat, vertex_vec);
+    if (vertex_vec.size() != (size_t)(grid_size * grid_size * WALL_GEOMETRY_SIZE))
+        return -1;
+    const float *p_quad_xy = vertex_vec.data();
 
-    // Bottom-left corner of texture
-    glTexCoord2f(0.0f, 0.0f);
-    glVertex2f(quad_vertices_vec[3].x, quad_vertices_vec[3].y);
+    // Iterate through the maze grid rows
+    for (int grid_row_i = 0; grid_row_i < grid_size; grid_row_i++) // image bottom to top
+    {
+        // Iterate through each column in the maze row
+        for (int grid_col_i = 0; grid_col_i < grid_size; grid_col_i++) // image left to right
+        {
+            // Show the state images on the wall corresponding to the selected control point
+            bool is_selected_wall =
+                (cpSelectedInd == 0 && grid_row_i == grid_size - 1 && grid_col_i == 0) ||
+                (cpSelectedInd == 1 && grid_row_i == grid_size - 1 && grid_col_i == grid_size - 1) ||
+                (cpSelectedInd == 2 && grid_row_i == 0 && grid_col_i == grid_size - 1) ||
+                (cpSelectedInd == 3 && grid_row_i == 0 && grid_col_i == 0);
+
+            // Draw the wall, compositing the state images in the shader
+            if (drawQuadImage(r_renderer, p_quad_xy, texture_array_id, wall_layer,
+                              is_selected_wall ? overlay_layer_arr : no_overlay_layer_arr) != 0)
+                return -1;
+            p_quad_xy += WALL_GEOMETRY_SIZE;
+        }
+    }
 
-    // End drawing
-    glEnd();
+    // // Print wall params
+    // dbLogQuadParams("quad_vec");
 
-    // Check and return GL status
+    // Return GL status
     return checkErrorGL(__LINE__, __FILE__);
 }
 
-int drawWalls(cv::Mat hom_mat, std::array<std::array<float, 6>, 4> ctrl_point_params, GLuint fbo_texture_id, ILuint img_wall_id, ILuint img_mode_mon_id, ILuint img_mode_param_id, ILuint img_mode_cal_id)
+void publishLiveCalibration()
 {
-    // Enable OpenGL texture mapping
-    glEnable(GL_TEXTURE_2D);
+    if (!isCalLive)
+        return;
 
-    // // TEMP
-    // dbLogCtrlPointParams(ctrl_point_params);
+    std_msgs::Float32MultiArray msg;
+    packCalibrationMsg(winMonInd, calModeInd, ctrlPointParams, homMat, msg.data);
+    calLivePub.publish(msg);
+}
 
-    // Iterate through the maze grid rows
-    for (float grid_row_i = 0; grid_row_i < MAZE_SIZE; grid_row_i++) // image bottom to top
+void applyCalActions()
+{
+    int action_flags = calActionFlags;
+    calActionFlags = CAL_ACTION_NONE;
+
+    // Load the coordinates from the XML file, or from a save the writer has not finished yet
+    if (action_flags & CAL_ACTION_LOAD)
     {
-        // Iterate through each column in the maze row
-        for (float grid_col_i = 0; grid_col_i < MAZE_SIZE; grid_col_i++) // image left to right
-        {
-            //  Create merged image for the wall corresponding to the selected control point
-            if (
-                (cpSelectedInd == 0 && grid_row_i == MAZE_SIZE - 1 && grid_col_i == 0) ||
-                (cpSelectedInd == 1 && grid_row_i == MAZE_SIZE - 1 && grid_col_i == MAZE_SIZE - 1) ||
-                (cpSelectedInd == 2 && grid_row_i == 0 && grid_col_i == MAZE_SIZE - 1) ||
-                (cpSelectedInd == 3 && grid_row_i == 0 && grid_col_i == 0))
-            {
-                ILuint img_merge1_id;
-                ILuint img_merge2_id;
-                ILuint img_merge3_id;
+        std::string file_path = formatCoordinatesFilePathXML(winMonInd, calModeInd, CONFIG_DIR_PATH);
+        beginStage(frameMetrics, STAGE_CALIBRATION);
+        if (getPendingCalibrationSave(winMonInd, calModeInd, ctrlPointParams, homMat))
+            ROS_INFO("[LOAD XML] Loaded Pending Save: File[%s]", file_path.c_str());
+        else
+            loadCoordinatesXML(homMat, ctrlPointParams, file_path, 3);
+        endStage(frameMetrics, STAGE_CALIBRATION);
+    }
 
-                // Merge test pattern and active monitor image
-                if (mergeImages(img_wall_id, img_mode_mon_id, img_merge1_id) != 0)
-                    return -1;
+    // Recompute homography matrix and wall parameters
+    if (action_flags & CAL_ACTION_UPDATE)
+    {
+        beginStage(frameMetrics, STAGE_GEOMETRY);
+        computeHomography(homMat, ctrlPointParams);
+        computeWallParamField(ctrlPointParams, mazeSize, wallParamField);
+        endStage(frameMetrics, STAGE_GEOMETRY);
+    }
 
-                // Merge previous image and active cp parameter image
-                if (mergeImages(img_merge1_id, img_mode_param_id, img_merge2_id) != 0)
-                    return -1;
+    // Stream the control points to the display node
+    if (action_flags & CAL_ACTION_PUBLISH)
+        publishLiveCalibration();
 
-                // Merge previous image and active calibration image
-                if (mergeImages(img_merge2_id, img_mode_cal_id, img_merge3_id) != 0)
-                    return -1;
+    // Queue the coordinates for the background writer, which saves the XML file and rebuilds the bundle
+    if (action_flags & CAL_ACTION_SAVE)
+    {
+        beginStage(frameMetrics, STAGE_CALIBRATION);
+        queueCalibrationSave(winMonInd, calModeInd, ctrlPointParams, homMat);
+        endStage(frameMetrics, STAGE_CALIBRATION);
+    }
+}
 
-                ilBindImage(img_merge3_id);
-            }
-            else
-            {
-                ilBindImage(img_wall_id); // show test pattern
-            }
-            if (checkErrorDevIL(__LINE__, __FILE__) != 0)
-                return -1;
+void queueCalibrationSave(int mon_id_ind, int mode_cal_ind, const std::array<std::array<float, 6>, 4> &ctrl_point_params, const cv::Mat &hom_mat)
+{
+    std::lock_guard<std::mutex> lock(saveMutex);
 
-            // Calculate width, height and shear for the current wall
-            float width = bilinearInterpolationFull(ctrl_point_params, 2, grid_row_i, grid_col_i, MAZE_SIZE);   // wall width
-            float height = bilinearInterpolationFull(ctrl_point_params, 3, grid_row_i, grid_col_i, MAZE_SIZE);  // wall height
-            float shear_x = bilinearInterpolationFull(ctrl_point_params, 4, grid_row_i, grid_col_i, MAZE_SIZE); // wall x shear
-            float shear_y = bilinearInterpolationFull(ctrl_point_params, 5, grid_row_i, grid_col_i, MAZE_SIZE); // wall x shear
+    // Replace a queued save of the same file, the writer has not started on it yet
+    for (CalibrationSave &r_save : saveQueueVec)
+    {
+        if (r_save.mon_ind == mon_id_ind && r_save.cal_ind == mode_cal_ind)
+        {
+            r_save.ctrl_point_params = ctrl_point_params;
+            hom_mat.copyTo(r_save.hom_mat);
+            r_save.n_coalesced++;
+            return;
+        }
+    }
 
-            // Get origin coordinates of wall
-            float x_origin = grid_col_i * WALL_SPACE_X;
-            float y_origin = grid_row_i * WALL_SPACE_Y;
+    CalibrationSave save;
+    save.mon_ind = mon_id_ind;
+    save.cal_ind = mode_cal_ind;
+    save.ctrl_point_params = ctrl_point_params;
+    save.hom_mat = hom_mat.clone();
+    saveQueueVec.push_back(save);
+    saveCond.notify_one();
+}
 
-            // Create wall vertices
-            std::vector<cv::Point2f> quad_vertices_raw = computeQuadVertices(x_origin, y_origin, width, height, shear_x, shear_y);
+bool getPendingCalibrationSave(int mon_id_ind, int mode_cal_ind, std::array<std::array<float, 6>, 4> &r_ctrl_point_params, cv::Mat &r_hom_mat)
+{
+    std::lock_guard<std::mutex> lock(saveMutex);
 
-            // Apply perspective warping to vertices
-            std::vector<cv::Point2f> quad_vertices_warped = computePerspectiveWarp(quad_vertices_raw, hom_mat);
+    // Queued saves are newer than the ones being written
+    for (const std::vector<CalibrationSave> *p_save_vec : {&saveQueueVec, &saveWritingVec})
+    {
+        for (const CalibrationSave &save : *p_save_vec)
+        {
+            if (save.mon_ind == mon_id_ind && save.cal_ind == mode_cal_ind)
+            {
+                r_ctrl_point_params = save.ctrl_point_params;
+                save.hom_mat.copyTo(r_hom_mat);
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-            // // Call to dbStoreQuadParams to store parameters for debugging
-            // dbStoreQuadParams(grid_row_i, grid_col_i, width, height, shear_x, shear_y, x_origin, y_origin, quad_vertices_raw, quad_vertices_warped);
+void saveWriterLoop()
+{
+    while (true)
+    {
+        // Wait for saves and take the whole queue, later saves queue up behind this batch
+        std::vector<CalibrationSave> batch_vec;
+        {
+            std::unique_lock<std::mutex> lock(saveMutex);
+            saveCond.wait(lock, []
+                          { return !saveQueueVec.empty() || isSaveQuit; });
+            if (saveQueueVec.empty())
+                return;
+            saveWritingVec.swap(saveQueueVec);
+            batch_vec = saveWritingVec;
+        }
 
-            // Set texture image
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, ilGetInteger(IL_IMAGE_WIDTH),
-                         ilGetInteger(IL_IMAGE_HEIGHT), 0, GL_RGB,
-                         GL_UNSIGNED_BYTE, ilGetData());
+        // Write outside the lock so queueing a save never waits on the disk
+        for (CalibrationSave &r_save : batch_vec)
+        {
+            std::string file_path = formatCoordinatesFilePathXML(r_save.mon_ind, r_save.cal_ind, CONFIG_DIR_PATH);
+            r_save.xml_status = saveCoordinatesXML(r_save.hom_mat, r_save.ctrl_point_params, file_path);
+        }
 
-            // Bind texture to framebuffer object
-            glBindTexture(GL_TEXTURE_2D, fbo_texture_id);
+        // Rebuild the calibration bundle read by the display node once for the batch
+        int bundle_status = convertCalibrationXMLToBundle(CONFIG_DIR_PATH, CAL_BUNDLE_PATH);
+        for (CalibrationSave &r_save : batch_vec)
+            r_save.bundle_status = bundle_status;
 
-            // Draw the wall
-            if (drawQuadImage(quad_vertices_warped) != 0)
-                return -1;
+        // Hand the results back and wake the main loop if it is waiting for events
+        {
+            std::lock_guard<std::mutex> lock(saveMutex);
+            saveWritingVec.clear();
+            saveDoneVec.insert(saveDoneVec.end(), batch_vec.begin(), batch_vec.end());
         }
+        glfwPostEmptyEvent();
     }
+}
 
-    // // Print wall params
-    // dbLogQuadParams("quad_vec");
+int startSaveWriter()
+{
+    isSaveQuit = false;
+    try
+    {
+        saveThread = std::thread(saveWriterLoop);
+    }
+    catch (const std::system_error &e)
+    {
+        ROS_ERROR("[SAVE] Failed to Start Writer Thread: Error[%s]", e.what());
+        return -1;
+    }
+    return 0;
+}
 
-    // Disable OpenGL texture mapping
-    glDisable(GL_TEXTURE_2D);
+void stopSaveWriter()
+{
+    if (!saveThread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        isSaveQuit = true;
+    }
+    saveCond.notify_one();
+    saveThread.join();
+    reportCalibrationSaves();
+}
 
-    // Return GL status
-    return checkErrorGL(__LINE__, __FILE__);
+int reportCalibrationSaves()
+{
+    std::vector<CalibrationSave> done_vec;
+    {
+        std::lock_guard<std::mutex> lock(saveMutex);
+        done_vec.swap(saveDoneVec);
+    }
+
+    for (const CalibrationSave &save : done_vec)
+    {
+        if (save.xml_status == 0)
+            ROS_INFO("[SAVE] Calibration XML Saved: Monitor[%d] Mode[%d] Coalesced[%d]", save.mon_ind, save.cal_ind, save.n_coalesced);
+        else
+            ROS_ERROR("[SAVE] Calibration XML Save Failed: Monitor[%d] Mode[%d]", save.mon_ind, save.cal_ind);
+
+        if (save.bundle_status != 0)
+            ROS_ERROR("[SAVE] Calibration Bundle Rebuild Failed: Monitor[%d] Mode[%d] Bundle[%s]", save.mon_ind, save.cal_ind, CAL_BUNDLE_PATH.c_str());
+    }
+    return (int)done_vec.size();
 }
 
 int main(int argc, char **argv)
@@ -534,18 +671,37 @@ int main(int argc, char **argv)
     ros::init(argc, argv, "projection_calibration", ros::init_options::AnonymousName);
     ros::NodeHandle n;
     ros::NodeHandle nh("~");
+
+    // Get the OpenGL synchronous error check flag
+    nh.param("gl_sync_checks", isGLSyncCheck, isGLSyncCheck);
+
+    // Get the frame metrics flag
+    bool is_frame_metrics = false;
+    nh.param("frame_metrics", is_frame_metrics, is_frame_metrics);
+
+    // Get the maze size
+    nh.param("maze_size", mazeSize, mazeSize);
+    if (checkMazeSize(mazeSize) != 0)
+        return -1;
+
+    // Advertise the live calibration stream
+    nh.param("live_calibration", isCalLive, isCalLive);
+    if (isCalLive)
+        calLivePub = n.advertise<std_msgs::Float32MultiArray>(CAL_LIVE_TOPIC, 10);
     ROS_INFO("RUNNING MAIN");
 
     // Log paths for debugging
     ROS_INFO("[SETUP] Config XML Path: %s", CONFIG_DIR_PATH.c_str());
     ROS_INFO("[SETUP] Display: Width=%d Height=%d AR=%0.2f", PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, PROJ_WIN_ASPECT_RATIO);
     ROS_INFO("[SETUP] Wall (Pxl): Width=%d Space=%d", WALL_WIDTH_PXL, WALL_HEIGHT_PXL);
+    ROS_INFO("[SETUP] Maze Size[%d]", mazeSize);
 
     // Initialize control point parameters
-    updateCalParams(ctrlPointParams, calModeInd);
+    updateCalParams(ctrlPointParams, calModeInd, mazeSize);
 
-    // Do initial computations of homography matrix
+    // Do initial computations of homography matrix and wall parameters
     computeHomography(homMat, ctrlPointParams);
+    computeWallParamField(ctrlPointParams, mazeSize, wallParamField);
 
     // --------------- OpenGL SETUP ---------------
 
@@ -562,7 +718,8 @@ int main(int argc, char **argv)
     pp_monitorIDVec = glfwGetMonitors(&nMonitors);
     ROS_INFO("[GLFW] Found %d monitors", nMonitors);
 
-    // Create GLFW window
+    // Create GLFW window with a core-profile context
+    setRendererWindowHints();
     p_windowID = glfwCreateWindow(PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, "", NULL, NULL);
     checkErrorGLFW(__LINE__, __FILE__);
     if (!p_windowID)
@@ -575,8 +732,10 @@ int main(int argc, char **argv)
     // Set OpenGL context and callbacks
     glfwMakeContextCurrent(p_windowID);
     gladLoadGL();
+    initDebugOutput();
     glfwSetKeyCallback(p_windowID, callbackKeyBinding);
     glfwSetFramebufferSizeCallback(p_windowID, callbackFrameBufferSizeGLFW);
+    glfwSetWindowRefreshCallback(p_windowID, callbackWindowRefreshGLFW);
 
     // Initialize FBO and texture
     GLuint fbo_id;
@@ -600,6 +759,15 @@ int main(int argc, char **argv)
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     checkErrorGL(__LINE__, __FILE__);
 
+    // Initialize the renderer
+    if (initRenderer(renderer) != 0)
+    {
+        ROS_ERROR("[OpenGL] Renderer Initialization Failed");
+        return -1;
+    }
+    initFrameMetrics(frameMetrics, "Calibration", is_frame_metrics);
+    initFrameMetrics(loopMetrics, "Calibration Loop", is_frame_metrics, false);
+
     // Update the window monitor and mode
     updateWindowMonMode(p_windowID, 0, pp_monitorIDVec, winMonInd, isFullScreen);
 
@@ -643,46 +811,104 @@ int main(int argc, char **argv)
         return -1;
     }
 
-    // _______________ MAIN LOOP _______________
-
-    while (!glfwWindowShouldClose(p_windowID) && ros::ok())
+    // Upload the wall and state images into one texture array, composited on the GPU when drawn
+    std::vector<ILuint> img_layer_id_vec;
+    img_layer_id_vec.insert(img_layer_id_vec.end(), imgWallIDVec.begin(), imgWallIDVec.end());
+    img_layer_id_vec.insert(img_layer_id_vec.end(), imgMonIDVec.begin(), imgMonIDVec.end());
+    img_layer_id_vec.insert(img_layer_id_vec.end(), imgParamIDVec.begin(), imgParamIDVec.end());
+    img_layer_id_vec.insert(img_layer_id_vec.end(), imgCalIDVec.begin(), imgCalIDVec.end());
+    if (loadGLTextureArray(img_layer_id_vec, texCalArrayID) != 0)
     {
+        ROS_ERROR("[OpenGL] Failed to load calibration texture array");
+        return -1;
+    }
 
-        // Clear back buffer for new frame
-        glClear(GL_COLOR_BUFFER_BIT);
-        if (checkErrorGL(__LINE__, __FILE__))
-            break;
+    // First texture array layer of each image set
+    const GLint layer_mon_offset = (GLint)imgWallIDVec.size();
+    const GLint layer_param_offset = layer_mon_offset + (GLint)imgMonIDVec.size();
+    const GLint layer_cal_offset = layer_param_offset + (GLint)imgParamIDVec.size();
 
-        // Draw/update wall images
-        if (drawWalls(homMat, ctrlPointParams, fbo_texture_id, imgWallIDVec[imgWallInd], imgMonIDVec[winMonInd], imgParamIDVec[imgParamInd], imgCalIDVec[calModeInd]) != 0)
-        {
-            ROS_ERROR("[MAIN] Draw Walls Threw Error");
-            return -1;
-        }
+    // Start the background writer so saving never blocks the render loop
+    if (startSaveWriter() != 0)
+        return -1;
 
-        // Draw/update control points
-        for (int i = 0; i < 4; i++)
-        {
-            // Get control point color based on cp selection
-            std::vector<float> cp_col = (cpSelectedInd != i) ? cpInactiveRGBVec : cpActiveRGBVec;
+    // _______________ MAIN LOOP _______________
 
-            // Draw the control point
-            if (drawControlPoint(ctrlPointParams[i][0], ctrlPointParams[i][1], CP_RADIUS_NDC, cp_col) != 0)
+    while (!glfwWindowShouldClose(p_windowID) && ros::ok())
+    {
+        // Redraw only after a key or window event, otherwise the last frame stays on screen
+        if (isFrameDirty)
+        {
+            // Clear back buffer for new frame
+            glClear(GL_COLOR_BUFFER_BIT);
+            if (checkErrorGL(__LINE__, __FILE__))
+                break;
+
+            // State images shown on the selected wall
+            std::array<GLint, N_OVERLAY_LAYERS> overlay_layer_arr = {{layer_mon_offset + winMonInd,
+                                                                      layer_param_offset + imgParamInd,
+                                                                      layer_cal_offset + calModeInd}};
+
+            // Draw/update wall images
+            beginStage(frameMetrics, STAGE_DRAW);
+            beginGPUTimer(frameMetrics);
+            if (drawWalls(renderer, homMat, wallParamField, texCalArrayID, imgWallInd, overlay_layer_arr) != 0)
             {
-                ROS_ERROR("[MAIN] Draw Control Point Threw Error");
+                ROS_ERROR("[MAIN] Draw Walls Threw Error");
+                stopSaveWriter();
                 return -1;
             }
+
+            // Draw/update control points
+            for (int i = 0; i < 4; i++)
+            {
+                // Get control point color based on cp selection
+                std::vector<float> cp_col = (cpSelectedInd != i) ? cpInactiveRGBVec : cpActiveRGBVec;
+
+                // Draw the control point
+                if (drawControlPoint(renderer, ctrlPointParams[i][0], ctrlPointParams[i][1], CP_RADIUS_NDC, cp_col) != 0)
+                {
+                    ROS_ERROR("[MAIN] Draw Control Point Threw Error");
+                    stopSaveWriter();
+                    return -1;
+                }
+            }
+            endGPUTimer(frameMetrics);
+            endStage(frameMetrics, STAGE_DRAW);
+
+            // Swap buffers
+            beginStage(frameMetrics, STAGE_SWAP);
+            glfwSwapBuffers(p_windowID);
+            if (checkErrorGLFW(__LINE__, __FILE__))
+                break;
+            if (checkErrorGL(__LINE__, __FILE__))
+                break;
+            endStage(frameMetrics, STAGE_SWAP);
+
+            // Record the frame timing
+            endFrame(frameMetrics);
+
+            // Frame is up to date
+            isFrameDirty = false;
         }
 
-        // Swap buffers and poll events
-        glfwSwapBuffers(p_windowID);
-        if (checkErrorGLFW(__LINE__, __FILE__))
-            break;
-        if (checkErrorGL(__LINE__, __FILE__))
-            break;
+        // Poll events, blocking for a while if the frame is clean
+        beginStage(loopMetrics, STAGE_EVENTS);
+        if (isFrameDirty)
+            glfwPollEvents();
+        else
+            glfwWaitEventsTimeout(EVENT_WAIT_TIMEOUT_S);
+        endStage(loopMetrics, STAGE_EVENTS);
+        endFrame(loopMetrics);
 
-        // Poll events
-        glfwPollEvents();
+        // Start the next frame interval after the wait, so idle time is not counted as frame time
+        restartFrameInterval(frameMetrics);
+
+        // Apply the calibration changes of the handled key events
+        applyCalActions();
+
+        // Report saves finished by the background writer
+        reportCalibrationSaves();
 
         // Exit condition
         if (glfwGetKey(p_windowID, GLFW_KEY_ESCAPE) == GLFW_PRESS || glfwWindowShouldClose(p_windowID))
@@ -702,11 +928,19 @@ int main(int argc, char **argv)
     else
         ROS_INFO("[LOOP TERMINATION] Reason Unknown");
 
+    // Finish any queued saves before exiting
+    stopSaveWriter();
+    ROS_INFO("[SHUTDOWN] Stopped save writer");
+
     // Delete FBO and textures
     glDeleteFramebuffers(1, &fbo_id);
     checkErrorGL(__LINE__, __FILE__);
     glDeleteTextures(1, &fbo_texture_id);
     checkErrorGL(__LINE__, __FILE__);
+    glDeleteTextures(1, &texCalArrayID);
+    deleteRenderer(renderer);
+    deleteFrameMetrics(frameMetrics);
+    checkErrorGL(__LINE__, __FILE__);
     ROS_INFO("[SHUTDOWN] Deleted FBO and textures");
 
     // Delete DevIL images
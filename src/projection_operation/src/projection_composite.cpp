@@ -0,0 +1,448 @@
+// ##########################################################################################################
+
+// ======================================== projection_composite.cpp ========================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_composite.h"
+
+#include <atomic>
+#include <utility>
+
+// SIMD kernels are only built for x86, other targets use the scalar kernel
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define COMPOSITE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC compiles any intrinsic without flags, GCC and Clang need the instruction set enabled per function
+#if defined(COMPOSITE_X86) && !defined(_MSC_VER)
+#define COMPOSITE_TARGET_SSE2 __attribute__((target("sse2")))
+#define COMPOSITE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define COMPOSITE_TARGET_SSE2
+#define COMPOSITE_TARGET_AVX2
+#endif
+
+// ================================================== VARIABLES ==================================================
+
+// Names of the kernels used when logging
+static const char *COMPOSITE_KERNEL_NAMES[N_COMPOSITE_KERNELS] = {
+    "scalar",
+    "sse2",
+    "avx2",
+};
+
+// Kernel selected by setCompositeKernel(), -1 until the first use selects the best supported one
+static std::atomic<int> compositeKernelInd(-1);
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Divides a product sum in [0, 255 * 255] by 255, rounding to nearest.
+ */
+static inline uint8_t divide255(uint32_t val)
+{
+    val += 128;
+    return (uint8_t)((val + (val >> 8)) >> 8);
+}
+
+/**
+ * @brief Scalar color key compositing, also used for the tail pixels of the SIMD kernels.
+ */
+static void compositeKeyScalar(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, int pxl_size, const uint8_t *p_key)
+{
+    for (size_t pxl_i = 0; pxl_i < n_pxl; pxl_i++)
+    {
+        const uint8_t *p_over_pxl = p_overlay + pxl_i * pxl_size;
+        bool is_key = p_over_pxl[0] == p_key[0] && p_over_pxl[1] == p_key[1] && p_over_pxl[2] == p_key[2];
+        const uint8_t *p_src_pxl = is_key ? p_base + pxl_i * pxl_size : p_over_pxl;
+        uint8_t *p_out_pxl = p_out + pxl_i * pxl_size;
+        for (int ch_i = 0; ch_i < pxl_size; ch_i++)
+            p_out_pxl[ch_i] = p_src_pxl[ch_i];
+    }
+}
+
+/**
+ * @brief Scalar alpha compositing of RGBA pixels, also used for the tail pixels of the SIMD kernels.
+ */
+static void compositeAlphaScalar(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl)
+{
+    for (size_t pxl_i = 0; pxl_i < n_pxl; pxl_i++)
+    {
+        const uint8_t *p_b = p_base + pxl_i * 4;
+        const uint8_t *p_o = p_overlay + pxl_i * 4;
+        uint8_t *p_d = p_out + pxl_i * 4;
+        uint32_t alpha = p_o[3];
+        uint8_t r = divide255(p_o[0] * alpha + p_b[0] * (255 - alpha));
+        uint8_t g = divide255(p_o[1] * alpha + p_b[1] * (255 - alpha));
+        uint8_t b = divide255(p_o[2] * alpha + p_b[2] * (255 - alpha));
+        uint8_t a = divide255(255 * alpha + p_b[3] * (255 - alpha));
+        p_d[0] = r;
+        p_d[1] = g;
+        p_d[2] = b;
+        p_d[3] = a;
+    }
+}
+
+#ifdef COMPOSITE_X86
+
+/**
+ * @brief Gets the 3 byte key color repeated over 16 bytes.
+ */
+static void fillKeyPattern(const uint8_t *p_key, uint8_t *p_pattern)
+{
+    for (int byte_i = 0; byte_i < 16; byte_i++)
+        p_pattern[byte_i] = p_key[byte_i % 3];
+}
+
+/**
+ * @brief SSE2 color key compositing of 3 byte pixels.
+ *
+ * Each 16 byte register holds 5 whole pixels. The per-byte key matches are ANDed into the first
+ * byte of each pixel, then spread back over its 3 bytes to form the select mask. Blocks advance
+ * by 15 bytes, so the 16th byte of each store is rewritten by the next block. It is written with
+ * the value of the input the output aliases, so an in-place composite never changes a byte a
+ * later block still has to read.
+ */
+COMPOSITE_TARGET_SSE2 static void compositeKeyRGB_SSE2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, const uint8_t *p_key)
+{
+    uint8_t key_pattern[16];
+    fillKeyPattern(p_key, key_pattern);
+    const __m128i key_vec = _mm_loadu_si128((const __m128i *)key_pattern);
+    const __m128i first_byte_mask = _mm_set_epi8(0, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1);
+    const __m128i last_byte_mask = p_out == p_base ? _mm_set_epi8(-1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0) : _mm_setzero_si128();
+
+    size_t n_bytes = n_pxl * 3;
+    size_t byte_i = 0;
+    for (; byte_i + 16 <= n_bytes; byte_i += 15)
+    {
+        __m128i base_vec = _mm_loadu_si128((const __m128i *)(p_base + byte_i));
+        __m128i over_vec = _mm_loadu_si128((const __m128i *)(p_overlay + byte_i));
+
+        // Select mask set on pixels matching the key
+        __m128i eq_vec = _mm_cmpeq_epi8(over_vec, key_vec);
+        __m128i pxl_vec = _mm_and_si128(eq_vec, _mm_and_si128(_mm_srli_si128(eq_vec, 1), _mm_srli_si128(eq_vec, 2)));
+        pxl_vec = _mm_and_si128(pxl_vec, first_byte_mask);
+        __m128i mask_vec = _mm_or_si128(pxl_vec, _mm_or_si128(_mm_slli_si128(pxl_vec, 1), _mm_slli_si128(pxl_vec, 2)));
+        mask_vec = _mm_or_si128(mask_vec, last_byte_mask);
+
+        __m128i out_vec = _mm_or_si128(_mm_and_si128(mask_vec, base_vec), _mm_andnot_si128(mask_vec, over_vec));
+        _mm_storeu_si128((__m128i *)(p_out + byte_i), out_vec);
+    }
+
+    size_t pxl_i = byte_i / 3;
+    compositeKeyScalar(p_base + byte_i, p_overlay + byte_i, p_out + byte_i, n_pxl - pxl_i, 3, p_key);
+}
+
+/**
+ * @brief SSE2 color key compositing of RGBA pixels, 4 pixels per register.
+ */
+COMPOSITE_TARGET_SSE2 static void compositeKeyRGBA_SSE2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, const uint8_t *p_key)
+{
+    // The alpha byte is forced to match so only the color decides
+    const __m128i key_vec = _mm_set1_epi32((int)(p_key[0] | (p_key[1] << 8) | (p_key[2] << 16) | 0xFF000000u));
+    const __m128i alpha_mask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i ones_vec = _mm_set1_epi32(-1);
+
+    size_t pxl_i = 0;
+    for (; pxl_i + 4 <= n_pxl; pxl_i += 4)
+    {
+        __m128i base_vec = _mm_loadu_si128((const __m128i *)(p_base + pxl_i * 4));
+        __m128i over_vec = _mm_loadu_si128((const __m128i *)(p_overlay + pxl_i * 4));
+
+        __m128i eq_vec = _mm_cmpeq_epi8(_mm_or_si128(over_vec, alpha_mask), key_vec);
+        __m128i mask_vec = _mm_cmpeq_epi32(eq_vec, ones_vec);
+
+        __m128i out_vec = _mm_or_si128(_mm_and_si128(mask_vec, base_vec), _mm_andnot_si128(mask_vec, over_vec));
+        _mm_storeu_si128((__m128i *)(p_out + pxl_i * 4), out_vec);
+    }
+
+    compositeKeyScalar(p_base + pxl_i * 4, p_overlay + pxl_i * 4, p_out + pxl_i * 4, n_pxl - pxl_i, 4, p_key);
+}
+
+/**
+ * @brief SSE2 alpha compositing of RGBA pixels, 4 pixels per register in two 16-bit halves.
+ */
+COMPOSITE_TARGET_SSE2 static void compositeAlphaRGBA_SSE2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl)
+{
+    const __m128i zero_vec = _mm_setzero_si128();
+    const __m128i alpha_mask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i c255_vec = _mm_set1_epi16(255);
+    const __m128i c128_vec = _mm_set1_epi16(128);
+
+    size_t pxl_i = 0;
+    for (; pxl_i + 4 <= n_pxl; pxl_i += 4)
+    {
+        __m128i base_vec = _mm_loadu_si128((const __m128i *)(p_base + pxl_i * 4));
+        __m128i over_vec = _mm_loadu_si128((const __m128i *)(p_overlay + pxl_i * 4));
+
+        // Overlay alpha of 255 so the alpha channel gets the "over" result
+        __m128i src_vec = _mm_or_si128(over_vec, alpha_mask);
+
+        __m128i half_vec[2];
+        for (int half_i = 0; half_i < 2; half_i++)
+        {
+            __m128i b16 = half_i == 0 ? _mm_unpacklo_epi8(base_vec, zero_vec) : _mm_unpackhi_epi8(base_vec, zero_vec);
+            __m128i s16 = half_i == 0 ? _mm_unpacklo_epi8(src_vec, zero_vec) : _mm_unpackhi_epi8(src_vec, zero_vec);
+            __m128i a16 = half_i == 0 ? _mm_unpacklo_epi8(over_vec, zero_vec) : _mm_unpackhi_epi8(over_vec, zero_vec);
+
+            // Broadcast each pixel's alpha over its 4 channels
+            a16 = _mm_shufflelo_epi16(a16, _MM_SHUFFLE(3, 3, 3, 3));
+            a16 = _mm_shufflehi_epi16(a16, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // (s * a + b * (255 - a)) / 255, rounded
+            __m128i sum16 = _mm_add_epi16(_mm_mullo_epi16(s16, a16), _mm_mullo_epi16(b16, _mm_sub_epi16(c255_vec, a16)));
+            sum16 = _mm_add_epi16(sum16, c128_vec);
+            half_vec[half_i] = _mm_srli_epi16(_mm_add_epi16(sum16, _mm_srli_epi16(sum16, 8)), 8);
+        }
+
+        _mm_storeu_si128((__m128i *)(p_out + pxl_i * 4), _mm_packus_epi16(half_vec[0], half_vec[1]));
+    }
+
+    compositeAlphaScalar(p_base + pxl_i * 4, p_overlay + pxl_i * 4, p_out + pxl_i * 4, n_pxl - pxl_i);
+}
+
+/**
+ * @brief Loads two 16 byte blocks into the low and high lanes of a 256-bit register.
+ */
+#define LOAD_LANES_AVX2(p_lo, p_hi) \
+    _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p_lo))), _mm_loadu_si128((const __m128i *)(p_hi)), 1)
+
+/**
+ * @brief AVX2 color key compositing of 3 byte pixels.
+ *
+ * Same scheme as compositeKeyRGB_SSE2() with the two 128-bit lanes holding consecutive 15 byte
+ * blocks, so 10 pixels are processed per iteration. The lanes are stored separately, low first.
+ */
+COMPOSITE_TARGET_AVX2 static void compositeKeyRGB_AVX2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, const uint8_t *p_key)
+{
+    uint8_t key_pattern[16];
+    fillKeyPattern(p_key, key_pattern);
+    const __m256i key_vec = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)key_pattern));
+    const __m256i first_byte_mask = _mm256_broadcastsi128_si256(_mm_set_epi8(0, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1));
+    const __m256i last_byte_mask = p_out == p_base ? _mm256_broadcastsi128_si256(_mm_set_epi8(-1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0)) : _mm256_setzero_si256();
+
+    size_t n_bytes = n_pxl * 3;
+    size_t byte_i = 0;
+    for (; byte_i + 31 <= n_bytes; byte_i += 30)
+    {
+        __m256i base_vec = LOAD_LANES_AVX2(p_base + byte_i, p_base + byte_i + 15);
+        __m256i over_vec = LOAD_LANES_AVX2(p_overlay + byte_i, p_overlay + byte_i + 15);
+
+        // Select mask set on pixels matching the key, byte shifts stay within each lane
+        __m256i eq_vec = _mm256_cmpeq_epi8(over_vec, key_vec);
+        __m256i pxl_vec = _mm256_and_si256(eq_vec, _mm256_and_si256(_mm256_srli_si256(eq_vec, 1), _mm256_srli_si256(eq_vec, 2)));
+        pxl_vec = _mm256_and_si256(pxl_vec, first_byte_mask);
+        __m256i mask_vec = _mm256_or_si256(pxl_vec, _mm256_or_si256(_mm256_slli_si256(pxl_vec, 1), _mm256_slli_si256(pxl_vec, 2)));
+        mask_vec = _mm256_or_si256(mask_vec, last_byte_mask);
+
+        __m256i out_vec = _mm256_blendv_epi8(over_vec, base_vec, mask_vec);
+        _mm_storeu_si128((__m128i *)(p_out + byte_i), _mm256_castsi256_si128(out_vec));
+        _mm_storeu_si128((__m128i *)(p_out + byte_i + 15), _mm256_extracti128_si256(out_vec, 1));
+    }
+
+    size_t pxl_i = byte_i / 3;
+    compositeKeyScalar(p_base + byte_i, p_overlay + byte_i, p_out + byte_i, n_pxl - pxl_i, 3, p_key);
+}
+
+/**
+ * @brief AVX2 color key compositing of RGBA pixels, 8 pixels per register.
+ */
+COMPOSITE_TARGET_AVX2 static void compositeKeyRGBA_AVX2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, const uint8_t *p_key)
+{
+    const __m256i key_vec = _mm256_set1_epi32((int)(p_key[0] | (p_key[1] << 8) | (p_key[2] << 16) | 0xFF000000u));
+    const __m256i alpha_mask = _mm256_set1_epi32((int)0xFF000000u);
+    const __m256i ones_vec = _mm256_set1_epi32(-1);
+
+    size_t pxl_i = 0;
+    for (; pxl_i + 8 <= n_pxl; pxl_i += 8)
+    {
+        __m256i base_vec = _mm256_loadu_si256((const __m256i *)(p_base + pxl_i * 4));
+        __m256i over_vec = _mm256_loadu_si256((const __m256i *)(p_overlay + pxl_i * 4));
+
+        __m256i eq_vec = _mm256_cmpeq_epi8(_mm256_or_si256(over_vec, alpha_mask), key_vec);
+        __m256i mask_vec = _mm256_cmpeq_epi32(eq_vec, ones_vec);
+
+        _mm256_storeu_si256((__m256i *)(p_out + pxl_i * 4), _mm256_blendv_epi8(over_vec, base_vec, mask_vec));
+    }
+
+    compositeKeyScalar(p_base + pxl_i * 4, p_overlay + pxl_i * 4, p_out + pxl_i * 4, n_pxl - pxl_i, 4, p_key);
+}
+
+/**
+ * @brief AVX2 alpha compositing of RGBA pixels, 8 pixels per register in two 16-bit halves.
+ */
+COMPOSITE_TARGET_AVX2 static void compositeAlphaRGBA_AVX2(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl)
+{
+    const __m256i zero_vec = _mm256_setzero_si256();
+    const __m256i alpha_mask = _mm256_set1_epi32((int)0xFF000000u);
+    const __m256i c255_vec = _mm256_set1_epi16(255);
+    const __m256i c128_vec = _mm256_set1_epi16(128);
+
+    size_t pxl_i = 0;
+    for (; pxl_i + 8 <= n_pxl; pxl_i += 8)
+    {
+        __m256i base_vec = _mm256_loadu_si256((const __m256i *)(p_base + pxl_i * 4));
+        __m256i over_vec = _mm256_loadu_si256((const __m256i *)(p_overlay + pxl_i * 4));
+        __m256i src_vec = _mm256_or_si256(over_vec, alpha_mask);
+
+        // Unpack and pack both work per lane, so the pixel order is preserved
+        __m256i half_vec[2];
+        for (int half_i = 0; half_i < 2; half_i++)
+        {
+            __m256i b16 = half_i == 0 ? _mm256_unpacklo_epi8(base_vec, zero_vec) : _mm256_unpackhi_epi8(base_vec, zero_vec);
+            __m256i s16 = half_i == 0 ? _mm256_unpacklo_epi8(src_vec, zero_vec) : _mm256_unpackhi_epi8(src_vec, zero_vec);
+            __m256i a16 = half_i == 0 ? _mm256_unpacklo_epi8(over_vec, zero_vec) : _mm256_unpackhi_epi8(over_vec, zero_vec);
+            a16 = _mm256_shufflelo_epi16(a16, _MM_SHUFFLE(3, 3, 3, 3));
+            a16 = _mm256_shufflehi_epi16(a16, _MM_SHUFFLE(3, 3, 3, 3));
+
+            __m256i sum16 = _mm256_add_epi16(_mm256_mullo_epi16(s16, a16), _mm256_mullo_epi16(b16, _mm256_sub_epi16(c255_vec, a16)));
+            sum16 = _mm256_add_epi16(sum16, c128_vec);
+            half_vec[half_i] = _mm256_srli_epi16(_mm256_add_epi16(sum16, _mm256_srli_epi16(sum16, 8)), 8);
+        }
+
+        _mm256_storeu_si256((__m256i *)(p_out + pxl_i * 4), _mm256_packus_epi16(half_vec[0], half_vec[1]));
+    }
+
+    compositeAlphaScalar(p_base + pxl_i * 4, p_overlay + pxl_i * 4, p_out + pxl_i * 4, n_pxl - pxl_i);
+}
+
+/**
+ * @brief Checks the CPU and operating system support AVX2.
+ */
+static bool detectAVX2()
+{
+#ifdef _MSC_VER
+    int info_arr[4];
+    __cpuid(info_arr, 0);
+    if (info_arr[0] < 7)
+        return false;
+
+    // The OS must save the YMM registers (OSXSAVE and XCR0 bits 1 and 2)
+    __cpuid(info_arr, 1);
+    bool is_osxsave = (info_arr[2] & (1 << 27)) != 0;
+    bool is_avx = (info_arr[2] & (1 << 28)) != 0;
+    if (!is_osxsave || !is_avx || (_xgetbv(0) & 0x6) != 0x6)
+        return false;
+
+    __cpuidex(info_arr, 7, 0);
+    return (info_arr[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif
+
+int getPixelSize(PixelFormat format)
+{
+    return format == PIXEL_RGBA ? 4 : 3;
+}
+
+const char *getCompositeKernelName(CompositeKernel kernel)
+{
+    return kernel >= 0 && kernel < N_COMPOSITE_KERNELS ? COMPOSITE_KERNEL_NAMES[kernel] : "unknown";
+}
+
+bool isCompositeKernelSupported(CompositeKernel kernel)
+{
+#ifdef COMPOSITE_X86
+    static const bool is_avx2 = detectAVX2();
+    if (kernel == KERNEL_SSE2)
+        return true;
+    if (kernel == KERNEL_AVX2)
+        return is_avx2;
+#endif
+    return kernel == KERNEL_SCALAR;
+}
+
+CompositeKernel getCompositeKernel()
+{
+    int kernel_ind = compositeKernelInd.load();
+    if (kernel_ind >= 0)
+        return (CompositeKernel)kernel_ind;
+
+    // Pick the widest supported kernel on first use
+    CompositeKernel kernel = KERNEL_SCALAR;
+    if (isCompositeKernelSupported(KERNEL_AVX2))
+        kernel = KERNEL_AVX2;
+    else if (isCompositeKernelSupported(KERNEL_SSE2))
+        kernel = KERNEL_SSE2;
+    compositeKernelInd.store(kernel);
+    ROS_INFO("[COMPOSITE] Selected Kernel[%s]", getCompositeKernelName(kernel));
+    return kernel;
+}
+
+int setCompositeKernel(CompositeKernel kernel)
+{
+    if (!isCompositeKernelSupported(kernel))
+    {
+        ROS_ERROR("[COMPOSITE] Kernel Not Supported: Kernel[%s]", getCompositeKernelName(kernel));
+        return -1;
+    }
+    compositeKernelInd.store(kernel);
+    return 0;
+}
+
+int compositeImages(const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, PixelFormat format, CompositeMode mode,
+                    const std::array<uint8_t, 3> &key_rgb)
+{
+    return compositeImagesWith(getCompositeKernel(), p_base, p_overlay, p_out, n_pxl, format, mode, key_rgb);
+}
+
+int compositeImagesWith(CompositeKernel kernel, const uint8_t *p_base, const uint8_t *p_overlay, uint8_t *p_out, size_t n_pxl, PixelFormat format, CompositeMode mode,
+                        const std::array<uint8_t, 3> &key_rgb)
+{
+    if (!isCompositeKernelSupported(kernel))
+    {
+        ROS_ERROR("[COMPOSITE] Kernel Not Supported: Kernel[%s]", getCompositeKernelName(kernel));
+        return -1;
+    }
+    if (mode == COMPOSITE_ALPHA && format != PIXEL_RGBA)
+    {
+        ROS_ERROR("[COMPOSITE] Alpha Mode Requires RGBA: Format[%d]", format);
+        return -1;
+    }
+
+    // Match the key to the channel order of the pixels
+    uint8_t key_arr[3] = {key_rgb[0], key_rgb[1], key_rgb[2]};
+    if (format == PIXEL_BGR)
+        std::swap(key_arr[0], key_arr[2]);
+    int pxl_size = getPixelSize(format);
+
+#ifdef COMPOSITE_X86
+    if (kernel == KERNEL_AVX2)
+    {
+        if (mode == COMPOSITE_ALPHA)
+            compositeAlphaRGBA_AVX2(p_base, p_overlay, p_out, n_pxl);
+        else if (pxl_size == 4)
+            compositeKeyRGBA_AVX2(p_base, p_overlay, p_out, n_pxl, key_arr);
+        else
+            compositeKeyRGB_AVX2(p_base, p_overlay, p_out, n_pxl, key_arr);
+        return 0;
+    }
+    if (kernel == KERNEL_SSE2)
+    {
+        if (mode == COMPOSITE_ALPHA)
+            compositeAlphaRGBA_SSE2(p_base, p_overlay, p_out, n_pxl);
+        else if (pxl_size == 4)
+            compositeKeyRGBA_SSE2(p_base, p_overlay, p_out, n_pxl, key_arr);
+        else
+            compositeKeyRGB_SSE2(p_base, p_overlay, p_out, n_pxl, key_arr);
+        return 0;
+    }
+#endif
+
+    if (mode == COMPOSITE_ALPHA)
+        compositeAlphaScalar(p_base, p_overlay, p_out, n_pxl);
+    else
+        compositeKeyScalar(p_base, p_overlay, p_out, n_pxl, pxl_size, key_arr);
+    return 0;
+}
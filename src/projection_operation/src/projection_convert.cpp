@@ -0,0 +1,56 @@
+// ##########################################################################################################
+
+// ========================================= projection_convert.cpp =========================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_convert.h"
+
+// ================================================== FUNCTIONS ==================================================
+
+int parseConvertArgs(int argc, char **argv)
+{
+    for (int arg_i = 1; arg_i < argc; arg_i++)
+    {
+        std::string arg_str = argv[arg_i];
+        size_t eq_pos = arg_str.find('=');
+        if (arg_str.compare(0, 2, "--") != 0 || eq_pos == std::string::npos)
+        {
+            ROS_ERROR("[CONVERT] Invalid Argument: Arg[%s] Expected[--<option>=<value>]", arg_str.c_str());
+            return -1;
+        }
+        std::string key_str = arg_str.substr(2, eq_pos - 2);
+        std::string val_str = arg_str.substr(eq_pos + 1);
+
+        if (key_str == "mode")
+            convertModeStr = val_str;
+        else if (key_str == "config_dir")
+            convertConfigDirPath = val_str;
+        else if (key_str == "bundle")
+            convertBundlePath = val_str;
+        else
+        {
+            ROS_ERROR("[CONVERT] Unknown Option: Option[%s]", key_str.c_str());
+            return -1;
+        }
+    }
+
+    if (convertModeStr != "to_bin" && convertModeStr != "to_xml")
+    {
+        ROS_ERROR("[CONVERT] Invalid Mode: Mode[%s] Expected[to_bin|to_xml]", convertModeStr.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (parseConvertArgs(argc, argv) != 0)
+        return -1;
+
+    if (convertModeStr == "to_bin")
+        return convertCalibrationXMLToBundle(convertConfigDirPath, convertBundlePath);
+    return convertCalibrationBundleToXML(convertBundlePath, convertConfigDirPath);
+}
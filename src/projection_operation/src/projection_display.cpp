@@ -50,14 +50,57 @@ void callbackKeyBinding(GLFWwindow *window, int key, int scancode, int action, i
         {
             int mon_id_ind = isWinOnProj ? projMonIndArr[proj_i] : winMonIndDefault; // Show image on default or projector monitor
             updateWindowMonMode(p_windowIDVec[proj_i], proj_i, pp_monitorIDVec, mon_id_ind, isFullScreen);
+            markWindowDirty(p_windowIDVec[proj_i], DIRTY_WINDOW);
         }
     }
 }
 
 void callbackFrameBufferSizeGLFW(GLFWwindow *window, int width, int height)
 {
-    glViewport(0, 0, width, height);
-    checkErrorGL(__LINE__, __FILE__);
+    // Store the new size for presenting, the viewport is set by the render pass
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+        {
+            if (p_windowIDVec[proj_i] == window)
+                winFrameSizeVec[proj_i] = {{width, height}};
+        }
+    }
+    markWindowDirty(window, DIRTY_WINDOW);
+}
+
+void callbackWindowRefreshGLFW(GLFWwindow *window)
+{
+    markWindowDirty(window, DIRTY_WINDOW);
+}
+
+void markWindowDirty(GLFWwindow *p_window_id, int flags)
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        if (p_windowIDVec[proj_i] == p_window_id)
+            projDirtyVec[proj_i] |= flags;
+    }
+}
+
+int takeProjDirty(int proj_ind)
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    int dirty_flags = projDirtyVec[proj_ind];
+    projDirtyVec[proj_ind] = DIRTY_NONE;
+    return dirty_flags;
+}
+
+bool isAnyProjDirty()
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        if (projDirtyVec[proj_i] != DIRTY_NONE)
+            return true;
+    }
+    return false;
 }
 
 static void callbackErrorGLFW(int error, const char *description)
@@ -67,6 +110,10 @@ static void callbackErrorGLFW(int error, const char *description)
 
 int checkErrorGL(int line, const char *file_str, const char *msg_str)
 {
+    // Skip the synchronous check unless enabled
+    if (!isGLSyncCheck)
+        return 0;
+
     GLenum gl_err;
     while ((gl_err = glGetError()) != GL_NO_ERROR)
     {
@@ -102,8 +149,12 @@ int setupProjGLFW(
     GLuint &r_fbo_id,
     GLuint &r_fbo_texture_id)
 {
-    // Create GLFW window
-    pp_window_id[win_ind] = glfwCreateWindow(PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, "", NULL, NULL);
+    // Create GLFW window with a core-profile context sharing objects with the first window
+    setRendererWindowHints();
+    if (isHeadless)
+        setHeadlessWindowHints();
+    GLFWwindow *p_share_window_id = win_ind > 0 ? pp_window_id[0] : NULL;
+    pp_window_id[win_ind] = glfwCreateWindow(PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, "", NULL, p_share_window_id);
     if (!pp_window_id[win_ind])
     {
         glfwTerminate();
@@ -114,9 +165,64 @@ int setupProjGLFW(
     // Set OpenGL context and callbacks
     glfwMakeContextCurrent(pp_window_id[win_ind]);
     gladLoadGL();
+    initDebugOutput();
     glfwSetKeyCallback(pp_window_id[win_ind], callbackKeyBinding);
     glfwSetFramebufferSizeCallback(pp_window_id[win_ind], callbackFrameBufferSizeGLFW);
+    glfwSetWindowRefreshCallback(pp_window_id[win_ind], callbackWindowRefreshGLFW);
+
+    // Set up the FBO the projector renders into
+    if (createProjFBO(r_fbo_id, r_fbo_texture_id) != 0)
+        return -1;
+
+    // Set window to wondowed mode on the second monitor
+    if (isHeadless)
+    {
+        ROS_INFO("[GLFW] Setup Headless Window[%d]", win_ind);
+    }
+    else if (updateWindowMonMode(pp_window_id[win_ind], win_ind, pp_r_monitor_id, mon_id_ind, isFullScreen) != 0)
+    {
+        ROS_ERROR("[GLFW] Failed to Update Window[%d] Monitor[%d] Mode", win_ind, mon_id_ind);
+        return -1;
+    }
+    else
+    {
+        ROS_INFO("[GLFW] Setup Window[%d] On Monitor[%d]", win_ind, mon_id_ind);
+    }
 
+    // Store the initial back buffer size for presenting
+    glfwGetFramebufferSize(pp_window_id[win_ind], &winFrameSizeVec[win_ind][0], &winFrameSizeVec[win_ind][1]);
+
+    // Check for GL errors
+    checkErrorGL(__LINE__, __FILE__);
+
+    return 0;
+}
+
+int setupProjHeadlessEGL(int win_ind, GLuint &r_fbo_id, GLuint &r_fbo_texture_id)
+{
+    // Create the context sharing objects with the first one and load the OpenGL functions through EGL
+    const HeadlessContextEGL *p_shared_context = win_ind > 0 ? &headlessContextVec[0] : nullptr;
+    if (createHeadlessContext(headlessContextVec[win_ind], p_shared_context) != 0 ||
+        makeHeadlessContextCurrent(headlessContextVec[win_ind]) != 0)
+        return -1;
+    if (!gladLoadGLLoader((GLADloadproc)getHeadlessProcAddress))
+    {
+        ROS_ERROR("[EGL] Failed to Load OpenGL Functions for Context[%d]", win_ind);
+        return -1;
+    }
+    initDebugOutput();
+    ROS_INFO("[EGL] Setup Headless Context[%d]: Renderer[%s] Version[%s]", win_ind, glGetString(GL_RENDERER), glGetString(GL_VERSION));
+
+    // Set up the FBO the projector renders into, there is no window to present it to
+    if (createProjFBO(r_fbo_id, r_fbo_texture_id) != 0)
+        return -1;
+    winFrameSizeVec[win_ind] = {PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL};
+
+    return checkErrorGL(__LINE__, __FILE__);
+}
+
+int createProjFBO(GLuint &r_fbo_id, GLuint &r_fbo_texture_id)
+{
     // Generate and set up the FBO
     glGenFramebuffers(1, &r_fbo_id);
     glBindFramebuffer(GL_FRAMEBUFFER, r_fbo_id);
@@ -142,20 +248,14 @@ int setupProjGLFW(
     // Unbind the FBO
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    // Set window to wondowed mode on the second monitor
-    if (updateWindowMonMode(pp_window_id[win_ind], win_ind, pp_r_monitor_id, mon_id_ind, isFullScreen) != 0)
-    {
-        ROS_ERROR("[GLFW] Failed to Update Window[%d] Monitor[%d] Mode", win_ind, mon_id_ind);
-        return -1;
-    }
-    else
-    {
-        ROS_INFO("[GLFW] Setup Window[%d] On Monitor[%d]", win_ind, mon_id_ind);
-    }
-
-    // Check for GL errors
-    checkErrorGL(__LINE__, __FILE__);
+    return 0;
+}
 
+int makeProjContextCurrent(int proj_ind)
+{
+    if (isHeadless && IS_HEADLESS_EGL)
+        return makeHeadlessContextCurrent(headlessContextVec[proj_ind]);
+    glfwMakeContextCurrent(p_windowIDVec[proj_ind]);
     return 0;
 }
 
@@ -163,9 +263,6 @@ int updateWindowMonMode(GLFWwindow *p_window_id, int win_ind, GLFWmonitor **&pp_
 {
     int x_pos, y_pos;
 
-    // Set the current OpenGL context to the window
-    glfwMakeContextCurrent(p_window_id);
-
     // Get GLFWmonitor for active monitor
     GLFWmonitor *p_monitor_id = pp_r_monitor_id[mon_id_ind];
 
@@ -226,129 +323,552 @@ int updateWindowMonMode(GLFWwindow *p_window_id, int win_ind, GLFWmonitor **&pp_
     return 0;
 }
 
-int drawQuadImage(std::vector<cv::Point2f> quad_vertices_vec)
+int updateWallGeometry(std::array<CalibrationParams, N_CAL_MODES> &r_cal_params_arr, GLuint &r_vbo_id)
 {
+    // Compute the warped corners for every calibration mode wall [left, middle, right]
+    std::vector<float> vertex_vec;
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+    {
+        computeWallVertices(r_cal_params_arr[cal_i].param_field, r_cal_params_arr[cal_i].hom_mat, vertex_vec);
+    }
 
-    // Start drawing a quadrilateral
-    glBegin(GL_QUADS);
+    // Generate the vertex buffer on first use
+    if (r_vbo_id == 0)
+    {
+        glGenBuffers(1, &r_vbo_id);
+    }
 
-    // Set the color to white (for texture mapping)
-    /// @note: this is nececary when drawing the control points
-    glColor3f(1.0f, 1.0f, 1.0f);
+    // Upload the corners
+    glBindBuffer(GL_ARRAY_BUFFER, r_vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, vertex_vec.size() * sizeof(GLfloat), vertex_vec.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Set texture and vertex coordinates for each corner
+    // Check and return GL status
+    return checkErrorGL(__LINE__, __FILE__);
+}
 
-    // Top-left corner of texture
-    glTexCoord2f(0.0f, 1.0f);
-    glVertex2f(quad_vertices_vec[0].x, quad_vertices_vec[0].y);
+int updateWallImages(int proj_ind, GLuint &r_vbo_id)
+{
+    // Get the image layer of every wall in the same order as the wall geometry
+    std::vector<GLint> layer_vec;
+    layer_vec.reserve(N_CAL_MODES * mazeSize * mazeSize);
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+    {
+        for (int grid_row_i = 0; grid_row_i < mazeSize; grid_row_i++)
+        {
+            for (int grid_col_i = 0; grid_col_i < mazeSize; grid_col_i++)
+            {
+                int wall_row = mazeSize - 1 - grid_row_i;
+                int wall_col = grid_col_i;
+                layer_vec.push_back(imgProjMapVec[getImgProjMapInd(proj_ind, wall_row, wall_col, cal_i, mazeSize)]);
+            }
+        }
+    }
 
-    // Top-right corner of texture
-    glTexCoord2f(1.0f, 1.0f);
-    glVertex2f(quad_vertices_vec[1].x, quad_vertices_vec[1].y);
+    // Generate the layer buffer on first use
+    if (r_vbo_id == 0)
+    {
+        glGenBuffers(1, &r_vbo_id);
+    }
 
-    // Bottom-right corner of texture
-    glTexCoord2f(1.0f, 0.0f);
-    glVertex2f(quad_vertices_vec[2].x, quad_vertices_vec[2].y);
+    // Upload the layers
+    glBindBuffer(GL_ARRAY_BUFFER, r_vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, layer_vec.size() * sizeof(GLint), layer_vec.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Bottom-left corner of texture
-    glTexCoord2f(0.0f, 0.0f);
-    glVertex2f(quad_vertices_vec[3].x, quad_vertices_vec[3].y);
+    // Check and return GL status
+    return checkErrorGL(__LINE__, __FILE__);
+}
 
-    // End drawing
-    glEnd();
+int drawWalls(
+    RendererGL &r_renderer,
+    GLuint wall_vao_id,
+    GLuint texture_array_id)
+{
+    // Draw every calibration mode wall [left, middle, right] in one call
+    drawWallsInstanced(r_renderer, wall_vao_id, N_CAL_MODES * mazeSize * mazeSize, texture_array_id);
 
     // Check and return GL status
     return checkErrorGL(__LINE__, __FILE__);
 }
 
-int drawWalls(
-    int proj_ind,
-    int mon_id_ind,
-    GLFWwindow *p_window_id,
-    GLuint fbo_texture_id,
-    std::vector<ILuint> &r_image_id_vec)
+int renderProjFrame(int proj_ind, int dirty_flags)
 {
+    // Keep the FBO contents if only the window changed
+    if (!(dirty_flags & (DIRTY_SCENE | DIRTY_CALIBRATION)))
+        return 0;
 
-    // Enable OpenGL texture mapping
-    glEnable(GL_TEXTURE_2D);
+    FrameMetrics &r_metrics = frameMetricsVec[proj_ind];
 
-    // Draw wall images for each calibration mode wall [left, middle, right]
-    for (int cal_i = 0; cal_i < 3; cal_i++)
+    // Rebake the wall geometry if the calibration changed
+    if (dirty_flags & DIRTY_CALIBRATION)
     {
-        // Initialize control point parameter array and homography matrix
-        std::array<std::array<float, 6>, 4> ctrl_point_params;
-        cv::Mat hom_mat = cv::Mat::eye(3, 3, CV_32F);
-
-        // Load the image transform coordinates from the XML file
-        std::string file_path = formatCoordinatesFilePathXML(mon_id_ind, cal_i, CONFIG_DIR_PATH);
-        if (loadCoordinatesXML(hom_mat, ctrl_point_params, file_path, 0) != 0)
+        beginStage(r_metrics, STAGE_GEOMETRY);
+        if (updateWallGeometry(calParamsVec[proj_ind], wallVboIDVec[proj_ind]) != 0)
         {
-            ROS_ERROR("XML: Missing XML File[%s]", file_path.c_str());
+            ROS_ERROR("[RENDER] Failed to Update Wall Geometry for Window[%d]", proj_ind);
             return -1;
         }
+        endStage(r_metrics, STAGE_GEOMETRY);
+    }
+
+    // Bind the projector's FBO at its full resolution
+    glBindFramebuffer(GL_FRAMEBUFFER, fboIDVec[proj_ind]);
+    glViewport(0, 0, PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL);
+
+    // Clear the FBO for the new frame
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Draw the walls
+    beginStage(r_metrics, STAGE_DRAW);
+    beginGPUTimer(r_metrics);
+    if (drawWalls(rendererVec[proj_ind], wallVaoIDVec[proj_ind], texWallArrayID) != 0)
+    {
+        ROS_ERROR("[RENDER] Failed to Draw Walls for Window[%d]", proj_ind);
+        return -1;
+    }
+    endGPUTimer(r_metrics);
+    endStage(r_metrics, STAGE_DRAW);
+
+    // Unbind the texture
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Unbind the FBO
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return checkErrorGL(__LINE__, __FILE__);
+}
+
+int presentProjFrame(int proj_ind)
+{
+    GLFWwindow *p_window_id = p_windowIDVec[proj_ind];
+
+    // Get the current size of the window's back buffer
+    std::array<int, 2> win_size;
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        win_size = winFrameSizeVec[proj_ind];
+    }
+
+    // Scale the FBO contents onto the back buffer
+    beginStage(frameMetricsVec[proj_ind], STAGE_SWAP);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fboIDVec[proj_ind]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL,
+                      0, 0, win_size[0], win_size[1],
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Swap buffers
+    glfwSwapBuffers(p_window_id);
+    if (checkErrorGLFW(__LINE__, __FILE__) ||
+        checkErrorGL(__LINE__, __FILE__))
+        return -1;
+    endStage(frameMetricsVec[proj_ind], STAGE_SWAP);
 
-        // TEMP 
-        computeHomography(hom_mat, ctrl_point_params);
+    // Record the frame timing
+    endFrame(frameMetricsVec[proj_ind]);
 
-        // Iterate through the maze grid
-        for (float grid_row_i = 0; grid_row_i < MAZE_SIZE; grid_row_i++)
+    return 0;
+}
+
+int readProjFrame(int proj_ind, cv::Mat &r_frame_mat)
+{
+    // Read the FBO pixels, which are stored bottom row first
+    cv::Mat rgba_mat(PROJ_WIN_HEIGHT_PXL, PROJ_WIN_WIDTH_PXL, CV_8UC4);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fboIDVec[proj_ind]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, GL_RGBA, GL_UNSIGNED_BYTE, rgba_mat.data);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    // Convert to top row first BGR
+    cv::flip(rgba_mat, rgba_mat, 0);
+    cv::cvtColor(rgba_mat, r_frame_mat, cv::COLOR_RGBA2BGR);
+
+    return checkErrorGL(__LINE__, __FILE__);
+}
+
+int renderHeadlessFrames(int n_frames)
+{
+    cv::Mat frame_mat;
+    for (int frame_i = 0; frame_i < n_frames && ros::ok(); frame_i++)
+    {
+        for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
         {
-            // Iterate through each cell in the maze row
-            for (float grid_col_i = 0; grid_col_i < MAZE_SIZE; grid_col_i++)
+            if (makeProjContextCurrent(proj_i) != 0)
+                return -1;
+
+            // Render the full scene every frame so each one is measured
+            if (renderProjFrame(proj_i, takeProjDirty(proj_i) | DIRTY_SCENE) != 0)
+            {
+                ROS_ERROR("[HEADLESS] Failed to Render Frame[%d] for Window[%d]", frame_i, proj_i);
+                return -1;
+            }
+
+            // Save the frame
+            if (!frameDumpDirPath.empty())
             {
-                // Get the image index for the current wall
-                int wall_row = MAZE_SIZE - 1 - (int)grid_row_i;
-                int wall_col = (int)grid_col_i;
-                int img_ind = IMG_PROJ_MAP[proj_ind][wall_row][wall_col][cal_i];
-
-                // Bind image
-                ilBindImage(r_image_id_vec[img_ind]); // show test pattern
-
-                // Calculate width, height and shear for the current wall
-                float width = bilinearInterpolationFull(ctrl_point_params, 2, grid_row_i, grid_col_i, MAZE_SIZE);   // wall width
-                float height = bilinearInterpolationFull(ctrl_point_params, 3, grid_row_i, grid_col_i, MAZE_SIZE);  // wall height
-                float shear_x = bilinearInterpolationFull(ctrl_point_params, 4, grid_row_i, grid_col_i, MAZE_SIZE); // wall x shear
-                float shear_y = bilinearInterpolationFull(ctrl_point_params, 5, grid_row_i, grid_col_i, MAZE_SIZE); // wall x shear
-
-                // Get origin coordinates of wall
-                float x_origin = grid_col_i * WALL_SPACE_X;
-                float y_origin = grid_row_i * WALL_SPACE_Y;
-
-                // Create wall vertices
-                std::vector<cv::Point2f> quad_vertices_raw = computeQuadVertices(x_origin, y_origin, width, height, shear_x, shear_y);
-
-                // Apply perspective warping to vertices
-                std::vector<cv::Point2f> quad_vertices_warped = computePerspectiveWarp(quad_vertices_raw, hom_mat);
-
-                // Set texture image
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, ilGetInteger(IL_IMAGE_WIDTH),
-                             ilGetInteger(IL_IMAGE_HEIGHT), 0, GL_RGB,
-                             GL_UNSIGNED_BYTE, ilGetData());
-
-                // Bind texture to framebuffer object
-                glBindTexture(GL_TEXTURE_2D, fbo_texture_id);
-                if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+                if (readProjFrame(proj_i, frame_mat) != 0)
+                    return -1;
+                std::string file_path = frameDumpDirPath + "/proj_" + std::to_string(proj_i) + "_frame_" + std::to_string(frame_i) + ".png";
+                if (!cv::imwrite(file_path, frame_mat))
                 {
-                    ROS_ERROR("Failed to Bind GL Frame Buffer Opbject for window[%d]", proj_ind);
+                    ROS_ERROR("[HEADLESS] Failed to Save Frame: File[%s]", file_path.c_str());
                     return -1;
                 }
+            }
+            else
+            {
+                // Wait for the GPU so the frame time covers the whole render
+                glFinish();
+            }
 
-                // Draw the wall
-                if (drawQuadImage(quad_vertices_warped) != 0)
-                    return -1;
+            // Record the frame timing
+            endFrame(frameMetricsVec[proj_i]);
+        }
+    }
+
+    ROS_INFO("[HEADLESS] Rendered Frames[%d] Projectors[%d] Dump Directory[%s]", n_frames, nProjectors, frameDumpDirPath.c_str());
+    return 0;
+}
+
+int compareGoldenFrames()
+{
+    int n_failed = 0;
+    cv::Mat frame_mat;
+    cv::Mat heatmap_mat;
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        // Read back the projector's last frame
+        if (makeProjContextCurrent(proj_i) != 0 || readProjFrame(proj_i, frame_mat) != 0)
+            return -1;
+
+        std::string ref_path = goldenDirPath + "/proj_" + std::to_string(proj_i) + ".png";
+
+        // Save the frame as the new reference
+        if (isGoldenUpdate)
+        {
+            if (!cv::imwrite(ref_path, frame_mat))
+            {
+                ROS_ERROR("[GOLDEN] Failed to Save Reference: File[%s]", ref_path.c_str());
+                return -1;
             }
+            ROS_INFO("[GOLDEN] Updated Reference: Window[%d] File[%s]", proj_i, ref_path.c_str());
+            continue;
+        }
+
+        // Compare against the reference
+        cv::Mat ref_mat = cv::imread(ref_path, cv::IMREAD_COLOR);
+        if (ref_mat.empty())
+        {
+            ROS_ERROR("[GOLDEN] Failed to Load Reference: File[%s]", ref_path.c_str());
+            return -1;
+        }
+        int n_bad_pxl = diffImages(frame_mat, ref_mat, goldenTolerance, heatmap_mat);
+        if (n_bad_pxl < 0)
+            return -1;
+
+        if (n_bad_pxl > goldenMaxBadPxl)
+        {
+            std::string diff_path = goldenDirPath + "/proj_" + std::to_string(proj_i) + "_diff.png";
+            cv::imwrite(diff_path, heatmap_mat);
+            ROS_ERROR("[GOLDEN] Mismatch: Window[%d] Bad Pixels[%d] Allowed[%d] Tolerance[%d] Heatmap[%s]",
+                      proj_i, n_bad_pxl, goldenMaxBadPxl, goldenTolerance, diff_path.c_str());
+            n_failed++;
+        }
+        else
+        {
+            ROS_INFO("[GOLDEN] Match: Window[%d] Bad Pixels[%d] Allowed[%d] Tolerance[%d]",
+                     proj_i, n_bad_pxl, goldenMaxBadPxl, goldenTolerance);
         }
     }
 
-    // Disable OpenGL texture mapping
-    glDisable(GL_TEXTURE_2D);
+    return n_failed == 0 ? 0 : -1;
+}
 
-    // Check for GL errors
-    checkErrorGL(__LINE__, __FILE__);
+void waitFrameBarrier(FrameBarrier &r_barrier)
+{
+    std::unique_lock<std::mutex> lock(r_barrier.mutex);
+    unsigned long generation = r_barrier.generation;
+
+    // Release everyone once the last thread arrives
+    if (++r_barrier.n_waiting == r_barrier.n_threads)
+    {
+        r_barrier.n_waiting = 0;
+        r_barrier.generation++;
+        r_barrier.cond.notify_all();
+        return;
+    }
+    r_barrier.cond.wait(lock, [&]
+                        { return r_barrier.generation != generation; });
+}
+
+void renderThreadLoop(int proj_ind)
+{
+    // Keep this projector's context current on its thread for its whole lifetime
+    glfwMakeContextCurrent(p_windowIDVec[proj_ind]);
+
+    unsigned long frame_ind = 0;
+    while (true)
+    {
+        // Wait for the next frame or the stop request
+        {
+            std::unique_lock<std::mutex> lock(frameMutex);
+            frameCond.wait(lock, [&]
+                           { return isRenderQuit || frameDispatchInd != frame_ind; });
+            if (isRenderQuit)
+                break;
+            frame_ind = frameDispatchInd;
+        }
 
+        // Render the scene into the FBO if needed
+        int dirty_flags = takeProjDirty(proj_ind);
+        bool is_ok = renderProjFrame(proj_ind, dirty_flags) == 0;
+
+        // Wait for every projector to finish rendering so they all present the same frame
+        waitFrameBarrier(presentBarrier);
+
+        // Present the frame if anything changed
+        if (is_ok && dirty_flags != DIRTY_NONE)
+            is_ok = presentProjFrame(proj_ind) == 0;
+
+        // Report the frame as done and wake the main thread to dispatch the next one
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            if (!is_ok)
+            {
+                ROS_ERROR("[RENDER THREAD] Failed to Render Frame for Window[%d]", proj_ind);
+                isRenderErr = true;
+            }
+            nFramePending--;
+        }
+        frameCond.notify_all();
+        glfwPostEmptyEvent();
+    }
+
+    // Release the context so the main thread can clean up
+    glfwMakeContextCurrent(NULL);
+}
+
+int startRenderThreads()
+{
+    // Release the main thread's context, each render thread owns one
+    glfwMakeContextCurrent(NULL);
+
+    presentBarrier.n_threads = nProjectors;
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+        renderThreadVec.push_back(std::thread(renderThreadLoop, proj_i));
+
+    ROS_INFO("[RENDER THREAD] Started Render Threads[%d]", nProjectors);
     return 0;
 }
 
+void stopRenderThreads()
+{
+    // Let the frame in flight finish so no thread is left waiting at the barrier
+    {
+        std::unique_lock<std::mutex> lock(frameMutex);
+        frameCond.wait(lock, []
+                       { return nFramePending == 0; });
+        isRenderQuit = true;
+    }
+    frameCond.notify_all();
+
+    for (std::thread &r_thread : renderThreadVec)
+        r_thread.join();
+    renderThreadVec.clear();
+
+    ROS_INFO("[RENDER THREAD] Stopped Render Threads");
+}
+
+int dispatchRenderFrame()
+{
+    std::lock_guard<std::mutex> lock(frameMutex);
+    if (isRenderErr)
+        return -1;
+
+    // Start a new frame once the previous one is done and a projector is dirty
+    if (nFramePending > 0)
+        return 0;
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        if (projDirtyVec[proj_i] != DIRTY_NONE)
+        {
+            frameDispatchInd++;
+            nFramePending = nProjectors;
+            frameCond.notify_all();
+            break;
+        }
+    }
+    return 0;
+}
+
+int loadProjCalibration(std::vector<std::array<CalibrationParams, N_CAL_MODES>> &r_cal_params_vec, std::vector<std::array<long long, N_CAL_MODES>> &r_file_time_vec)
+{
+    // Map the bundle once, each projector then decides whether its entries are current
+    long long bundle_time = 0;
+    MappedCalibrationBundle cal_bundle;
+    bool is_bundle_open = getFileModTime(calBundlePath, bundle_time) == 0 && openCalibrationBundle(calBundlePath, cal_bundle) == 0;
+    if (!is_bundle_open)
+        ROS_WARN("[CALIBRATION] Calibration Bundle Missing or Invalid, Loading XML Files: Bundle[%s]", calBundlePath.c_str());
+
+    int status = 0;
+    r_file_time_vec.assign(nProjectors, {});
+    for (int proj_i = 0; proj_i < nProjectors && status == 0; ++proj_i)
+    {
+        // Use the bundle unless an XML file of this monitor was written after it, or in the same
+        // second since modification times only have whole second resolution
+        bool is_bundle_current = is_bundle_open;
+        for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+        {
+            long long xml_time = 0;
+            getFileModTime(formatCoordinatesFilePathXML(projMonIndArr[proj_i], cal_i, calConfigDirPath), xml_time);
+            r_file_time_vec[proj_i][cal_i] = xml_time;
+            if (xml_time >= bundle_time)
+                is_bundle_current = false;
+        }
+
+        // Fall back to the XML files of this monitor if the bundle is older or has no entry for it
+        status = is_bundle_current ? loadCalibrationParams(cal_bundle, projMonIndArr[proj_i], mazeSize, r_cal_params_vec[proj_i]) : -1;
+        if (status != 0)
+        {
+            if (is_bundle_open)
+                ROS_WARN("[CALIBRATION] Calibration Bundle Older than the XML Files or Missing Entries, Loading XML Files: Window[%d] Monitor[%d]", proj_i, projMonIndArr[proj_i]);
+            status = loadCalibrationParams(projMonIndArr[proj_i], calConfigDirPath, mazeSize, r_cal_params_vec[proj_i]);
+        }
+        if (status != 0)
+            ROS_ERROR("[CALIBRATION] Failed to load calibration for Window[%d] Monitor[%d]", proj_i, projMonIndArr[proj_i]);
+    }
+    closeCalibrationBundle(cal_bundle);
+    return status;
+}
+
+void calWatchLoop()
+{
+    while (!isCalWatchQuit)
+    {
+        int status = waitDirWatcher(calDirWatcher, CAL_WATCH_TIMEOUT_MS);
+        if (status < 0)
+        {
+            ROS_ERROR("[CALIBRATION] Watch Failed, Hot Reload Stopped: Directory[%s]", calConfigDirPath.c_str());
+            return;
+        }
+        if (status == 0)
+            continue;
+
+        // Wait for the writer to finish, e.g. all the files of one calibration UI save
+        while (!isCalWatchQuit && (status = waitDirWatcher(calDirWatcher, CAL_RELOAD_DEBOUNCE_MS)) > 0)
+            ;
+        if (isCalWatchQuit || status < 0)
+            continue;
+
+        // Parse here so the main loop only swaps
+        std::vector<std::array<CalibrationParams, N_CAL_MODES>> cal_params_vec(nProjectors);
+        std::vector<std::array<long long, N_CAL_MODES>> file_time_vec;
+        if (loadProjCalibration(cal_params_vec, file_time_vec) != 0)
+        {
+            ROS_WARN("[CALIBRATION] Reload Failed, Keeping the Current Calibration");
+            continue;
+        }
+
+        // Merge entry by entry on top of anything staged, keeping live edits newer than their file
+        int n_kept = 0;
+        {
+            std::lock_guard<std::mutex> lock(calReloadMutex);
+            if (!isCalReloadReady)
+            {
+                calReloadVec = calParamsVec;
+                isCalReloadReady = true;
+            }
+            for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+            {
+                for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+                {
+                    if (calLiveTimeVec[proj_i][cal_i] > file_time_vec[proj_i][cal_i])
+                    {
+                        n_kept++;
+                        continue;
+                    }
+                    calReloadVec[proj_i][cal_i] = cal_params_vec[proj_i][cal_i];
+                    calLiveTimeVec[proj_i][cal_i] = 0;
+                }
+            }
+        }
+        glfwPostEmptyEvent();
+        ROS_INFO("[CALIBRATION] Reloaded Calibration Files: Kept Live Entries[%d]", n_kept);
+    }
+}
+
+int startCalWatch()
+{
+    if (openDirWatcher(calConfigDirPath, calDirWatcher) != 0)
+        return -1;
+    isCalWatchQuit = false;
+    calWatchThread = std::thread(calWatchLoop);
+    ROS_INFO("[CALIBRATION] Watching for Calibration Changes: Directory[%s]", calConfigDirPath.c_str());
+    return 0;
+}
+
+void stopCalWatch()
+{
+    if (!calWatchThread.joinable())
+        return;
+    isCalWatchQuit = true;
+    calWatchThread.join();
+    closeDirWatcher(calDirWatcher);
+}
+
+bool applyCalReload()
+{
+    std::lock_guard<std::mutex> reload_lock(calReloadMutex);
+    if (!isCalReloadReady)
+        return false;
+
+    // The render threads only read calParamsVec while a frame is in flight
+    std::lock_guard<std::mutex> frame_lock(frameMutex);
+    if (isRenderThreaded && nFramePending > 0)
+        return false;
+
+    calParamsVec.swap(calReloadVec);
+    isCalReloadReady = false;
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+        projDirtyVec[proj_i] |= DIRTY_CALIBRATION;
+    return true;
+}
+
+void callbackCalLive(const std_msgs::Float32MultiArray::ConstPtr &msg)
+{
+    int mon_id_ind;
+    int mode_cal_ind;
+    CalibrationParams cal_params;
+    if (unpackCalibrationMsg(msg->data, mon_id_ind, mode_cal_ind, cal_params.ctrl_point_params, cal_params.hom_mat) != 0)
+        return;
+
+    // Ignore monitors this node does not project on
+    if (std::find(projMonIndArr.begin(), projMonIndArr.end(), mon_id_ind) == projMonIndArr.end())
+        return;
+    computeWallParamField(cal_params.ctrl_point_params, mazeSize, cal_params.param_field);
+
+    {
+        // calParamsVec is only written by applyCalReload() under this lock, so it can be copied here
+        std::lock_guard<std::mutex> lock(calReloadMutex);
+        if (!isCalReloadReady)
+        {
+            calReloadVec = calParamsVec;
+            isCalReloadReady = true;
+        }
+        for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+        {
+            if (projMonIndArr[proj_i] == mon_id_ind)
+            {
+                calReloadVec[proj_i][mode_cal_ind] = cal_params;
+                calLiveTimeVec[proj_i][mode_cal_ind] = (long long)std::time(nullptr);
+            }
+        }
+    }
+    glfwPostEmptyEvent();
+}
+
 int main(int argc, char **argv)
 {
     //  _______________ SETUP _______________
@@ -357,28 +877,94 @@ int main(int argc, char **argv)
     ros::init(argc, argv, "projection_display", ros::init_options::AnonymousName);
     ros::NodeHandle n;
     ros::NodeHandle nh("~");
+
+    // Get the OpenGL synchronous error check flag
+    nh.param("gl_sync_checks", isGLSyncCheck, isGLSyncCheck);
+
+    // Get the render thread mode flag
+    nh.param("render_threads", isRenderThreaded, isRenderThreaded);
+
+    // Get the calibration directory, the bundle is looked for in the same directory
+    if (nh.getParam("config_dir", calConfigDirPath))
+        calBundlePath = calConfigDirPath + "/" + CAL_BUNDLE_FILE_NAME;
+
+    // Get the calibration hot reload and live streaming parameters
+    nh.param("hot_reload", isCalHotReload, isCalHotReload);
+    nh.param("live_calibration", isCalLive, isCalLive);
+
+    // Get the headless backend parameters
+    nh.param("headless", isHeadless, isHeadless);
+    nh.param("headless_frames", nHeadlessFrames, nHeadlessFrames);
+    nh.param("frame_dump_dir", frameDumpDirPath, frameDumpDirPath);
+    nh.param("golden_dir", goldenDirPath, goldenDirPath);
+    nh.param("golden_tolerance", goldenTolerance, goldenTolerance);
+    nh.param("golden_max_bad_pixels", goldenMaxBadPxl, goldenMaxBadPxl);
+    nh.param("golden_update", isGoldenUpdate, isGoldenUpdate);
+    if (isHeadless && isRenderThreaded)
+    {
+        ROS_WARN("[SETUP] Render Threads Disabled in Headless Mode");
+        isRenderThreaded = false;
+    }
+
+    // Get the maze size and the wall image map sized for it
+    nh.param("maze_size", mazeSize, mazeSize);
+    if (checkMazeSize(mazeSize) != 0)
+        return -1;
+    initImgProjMap(mazeSize, imgProjMapVec);
+    std::vector<int> img_proj_map_param_vec;
+    if (nh.getParam("image_map", img_proj_map_param_vec))
+    {
+        if (img_proj_map_param_vec.size() != imgProjMapVec.size())
+        {
+            ROS_ERROR("[SETUP] Image Map has Wrong Size: Entries[%zu] Expected[%zu] Maze Size[%d]",
+                      img_proj_map_param_vec.size(), imgProjMapVec.size(), mazeSize);
+            return -1;
+        }
+        for (int img_ind : img_proj_map_param_vec)
+        {
+            if (img_ind < 0 || img_ind >= (int)imgWallPathVec.size())
+            {
+                ROS_ERROR("[SETUP] Image Map Index Out of Range: Index[%d] Images[%zu]", img_ind, imgWallPathVec.size());
+                return -1;
+            }
+        }
+        imgProjMapVec = img_proj_map_param_vec;
+    }
+    else if (mazeSize != MAZE_SIZE)
+    {
+        ROS_WARN("[SETUP] No Image Map for Maze Size[%d], All Walls Blank", mazeSize);
+    }
+    ROS_INFO("[SETUP] Maze Size[%d] Walls per Projector[%d]", mazeSize, N_CAL_MODES * mazeSize * mazeSize);
+
+    // Get the frame metrics flag
+    nh.param("frame_metrics", isFrameMetrics, isFrameMetrics);
+    initFrameMetrics(loopMetrics, "Main Loop", isFrameMetrics, false);
     ROS_INFO("RUNNING MAIN");
 
     // Log paths for debugging
-    ROS_INFO("[SETUP] Config XML Path: %s", CONFIG_DIR_PATH.c_str());
+    ROS_INFO("[SETUP] Config XML Path: %s", calConfigDirPath.c_str());
     ROS_INFO("[SETUP] Display: Width=%d Height=%d AR=%0.2f", PROJ_WIN_WIDTH_PXL, PROJ_WIN_HEIGHT_PXL, PROJ_WIN_ASPECT_RATIO);
 
     // --------------- OpenGL SETUP V2 ---------------
 
-    // Initialize GLFW
+    // Initialize GLFW, unless rendering headless through EGL which needs no window system
+    bool is_glfw = !isHeadless || !IS_HEADLESS_EGL;
     glfwSetErrorCallback(callbackErrorGLFW);
-    if (!glfwInit())
+    if (isHeadless && is_glfw && setHeadlessInitHints() != 0)
+        return -1;
+    if (is_glfw && !glfwInit())
     {
         ROS_ERROR("[GLFW] Initialization Failed");
         return -1;
     }
 
     // Get the list of available monitors and their count
-    pp_monitorIDVec = glfwGetMonitors(&nMonitors);
+    if (is_glfw)
+        pp_monitorIDVec = glfwGetMonitors(&nMonitors);
     ROS_INFO("[GLFW] Monitors Found [%d] Projectors Sepcified[%d]", nMonitors, nProjectors);
 
     // Make sure nProj is not greater than the total number of monitors found
-    if (nProjectors > nMonitors)
+    if (!isHeadless && nProjectors > nMonitors)
     {
         ROS_ERROR("[GLFW] Error Fewer Monitors[%d] Found than Expected Projectors[%d]", nMonitors, nProjectors);
         return -1;
@@ -390,7 +976,9 @@ int main(int argc, char **argv)
         int mon_id_ind = winMonIndDefault; // Show image on default monitor
         // int mon_id_ind =  projMonIndArr[proj_i]; // Show image on projector monitor
 
-        if (setupProjGLFW(p_windowIDVec, proj_i, pp_monitorIDVec, mon_id_ind, fboIDVec[proj_i], fboTextureIDVec[proj_i]) != 0)
+        int setup_status = is_glfw ? setupProjGLFW(p_windowIDVec, proj_i, pp_monitorIDVec, mon_id_ind, fboIDVec[proj_i], fboTextureIDVec[proj_i])
+                                   : setupProjHeadlessEGL(proj_i, fboIDVec[proj_i], fboTextureIDVec[proj_i]);
+        if (setup_status != 0)
         {
             ROS_ERROR("[GLFW] Setup Failed for Window[%d]", proj_i);
             return -1;
@@ -409,60 +997,130 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    // --------------- OpenGL TEXTURE SETUP ---------------
+
+    // Upload the wall images once to the shared context
+    makeProjContextCurrent(0);
+    if (loadGLTextureArray(imgWallIDVec, texWallArrayID) != 0)
+    {
+        ROS_ERROR("[OpenGL] Failed to load wall textures");
+        return -1;
+    }
+
+    // Set up the renderer of each projector's context, reusing the first window's shader programs
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        makeProjContextCurrent(proj_i);
+        if (initRenderer(rendererVec[proj_i], proj_i > 0 ? &rendererVec[0] : nullptr) != 0)
+        {
+            ROS_ERROR("[OpenGL] Failed to initialize renderer for Window[%d]", proj_i);
+            return -1;
+        }
+        initFrameMetrics(frameMetricsVec[proj_i], "Window[" + std::to_string(proj_i) + "]", isFrameMetrics);
+    }
+
+    // --------------- CALIBRATION SETUP ---------------
+
+    // Load the calibration of every projector, later changes are picked up by the watcher thread
+    beginStage(loopMetrics, STAGE_CALIBRATION);
+    std::vector<std::array<long long, N_CAL_MODES>> cal_file_time_vec;
+    int cal_status = loadProjCalibration(calParamsVec, cal_file_time_vec);
+    endStage(loopMetrics, STAGE_CALIBRATION);
+    if (cal_status != 0)
+        return -1;
+
+    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    {
+        // Bake the wall geometry and image layers for this calibration
+        makeProjContextCurrent(proj_i);
+        if (updateWallGeometry(calParamsVec[proj_i], wallVboIDVec[proj_i]) != 0 ||
+            updateWallImages(proj_i, wallLayerVboIDVec[proj_i]) != 0 ||
+            createWallVertexArray(wallVboIDVec[proj_i], wallLayerVboIDVec[proj_i], wallVaoIDVec[proj_i]) != 0)
+        {
+            ROS_ERROR("[OpenGL] Failed to build wall geometry for Window[%d]", proj_i);
+            return -1;
+        }
+    }
+
+    // --------------- RENDER THREAD SETUP ---------------
+
+    // Move rendering onto one thread per projector if enabled
+    if (isRenderThreaded && startRenderThreads() != 0)
+    {
+        ROS_ERROR("[RENDER THREAD] Failed to Start Render Threads");
+        return -1;
+    }
+
     // _______________ MAIN LOOP _______________
 
     // Initialize a variable to check for errors and windows closed
     bool is_win_closed = false;
     bool is_err_thrown = false;
 
-    while (!is_err_thrown && !is_win_closed && ros::ok())
+    // Render the requested frames offscreen and skip the interactive loop
+    if (isHeadless && renderHeadlessFrames(nHeadlessFrames) != 0)
+        is_err_thrown = true;
+
+    // Log the frame timing of the whole run, a short run may end before the periodic summary
+    if (isHeadless && !is_err_thrown && isFrameMetrics)
+    {
+        for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+            logFrameMetrics(frameMetricsVec[proj_i]);
+    }
+
+    // Check the rendered frames against the reference images
+    if (isHeadless && !is_err_thrown && !goldenDirPath.empty() && compareGoldenFrames() != 0)
+        is_err_thrown = true;
+
+    // Watch the calibration files so edits show up without a restart
+    if (!isHeadless && isCalHotReload && startCalWatch() != 0)
+        ROS_WARN("[SETUP] Calibration Hot Reload Disabled");
+
+    // Apply the calibration streamed by the calibration node, callbacks run on the spinner thread
+    ros::AsyncSpinner ros_spinner(1);
+    if (!isHeadless && isCalLive)
+    {
+        calLiveSub = n.subscribe(CAL_LIVE_TOPIC, 10, callbackCalLive);
+        ros_spinner.start();
+    }
+
+    while (!isHeadless && !is_err_thrown && !is_win_closed && ros::ok())
     {
         is_win_closed = true;
 
+        // Swap in a calibration reloaded by the watcher thread
+        applyCalReload();
+
         // Update the window contents and process events for each projectors window
         for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
         {
             // Get the GLFW objects for this projector
             GLFWwindow *p_window_id = p_windowIDVec[proj_i];
-            GLuint fbo_texture_id = fboTextureIDVec[proj_i];
 
             if (!glfwWindowShouldClose(p_window_id))
             {
                 is_win_closed = false; // At least one window is still open
 
-                // Make the window's context current
-                glfwMakeContextCurrent(p_window_id);
-                if (glfwGetCurrentContext() != p_window_id)
-                {
-                    ROS_ERROR("[MAIN] Failed to Set GLFW Context for Window[%d]", proj_i);
-                    is_err_thrown = true;
-                    break;
-                }
-
-                // Clear back buffer for new frame
-                glClear(GL_COLOR_BUFFER_BIT);
-
-                // Draw the walls
-                if (drawWalls(proj_i, projMonIndArr[proj_i], p_windowIDVec[proj_i], fboTextureIDVec[proj_i], imgWallIDVec) != 0)
-                {
-                    ROS_ERROR("[MAIN] Failed to Draw Walls for Window[%d]", proj_i);
-                    is_err_thrown = true;
-                    break;
-                }
-
-                // Unbind the texture
-                glBindTexture(GL_TEXTURE_2D, 0);
-
-                // Unbind the FBO
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-                // Swap buffers
-                glfwSwapBuffers(p_window_id);
-                if (checkErrorGLFW(__LINE__, __FILE__) ||
-                    checkErrorGL(__LINE__, __FILE__))
+                // Redraw the projector only if something changed, otherwise its last frame stays on screen
+                int dirty_flags = isRenderThreaded ? DIRTY_NONE : takeProjDirty(proj_i);
+                if (dirty_flags != DIRTY_NONE)
                 {
-                    is_err_thrown = true;
-                    break;
+                    // Make the window's context current
+                    glfwMakeContextCurrent(p_window_id);
+                    if (glfwGetCurrentContext() != p_window_id)
+                    {
+                        ROS_ERROR("[MAIN] Failed to Set GLFW Context for Window[%d]", proj_i);
+                        is_err_thrown = true;
+                        break;
+                    }
+
+                    // Render the scene into the FBO if needed and present it
+                    if (renderProjFrame(proj_i, dirty_flags) != 0 || presentProjFrame(proj_i) != 0)
+                    {
+                        ROS_ERROR("[MAIN] Failed to Render Frame for Window[%d]", proj_i);
+                        is_err_thrown = true;
+                        break;
+                    }
                 }
             }
 
@@ -474,8 +1132,22 @@ int main(int argc, char **argv)
             }
         }
 
-        // Poll and process events for all windows
-        glfwPollEvents();
+        // Hand the dirty projectors to the render threads
+        if (isRenderThreaded && dispatchRenderFrame() != 0)
+        {
+            ROS_ERROR("[MAIN] Render Thread Threw Error");
+            is_err_thrown = true;
+            break;
+        }
+
+        // Poll and process events for all windows, blocking for a while if there is nothing to draw here
+        beginStage(loopMetrics, STAGE_EVENTS);
+        if (!isRenderThreaded && isAnyProjDirty())
+            glfwPollEvents();
+        else
+            glfwWaitEventsTimeout(EVENT_WAIT_TIMEOUT_S);
+        endStage(loopMetrics, STAGE_EVENTS);
+        endFrame(loopMetrics);
         if (checkErrorGLFW(__LINE__, __FILE__))
             break;
     }
@@ -490,26 +1162,48 @@ int main(int argc, char **argv)
         ROS_INFO("[LOOP TERMINATION] GLFW Window Should Close");
     else if (is_err_thrown)
         ROS_INFO("[LOOP TERMINATION] An Error Was Thrown");
+    else if (isHeadless)
+        ROS_INFO("[LOOP TERMINATION] Headless Frames Rendered");
     else
         ROS_INFO("[LOOP TERMINATION] Reason Unknown");
 
-    // Delete FBO and textures
-    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    // Stop the calibration watcher and the live calibration stream
+    stopCalWatch();
+    ros_spinner.stop();
+
+    // Stop the render threads and get the contexts back
+    if (isRenderThreaded)
+        stopRenderThreads();
+
+    // Delete FBO and textures, ending with the first window that owns the shared programs
+    for (int proj_i = nProjectors - 1; proj_i >= 0; --proj_i)
     {
+        makeProjContextCurrent(proj_i);
+        glDeleteVertexArrays(1, &wallVaoIDVec[proj_i]);
+        glDeleteBuffers(1, &wallVboIDVec[proj_i]);
+        glDeleteBuffers(1, &wallLayerVboIDVec[proj_i]);
+        deleteRenderer(rendererVec[proj_i]);
+        deleteFrameMetrics(frameMetricsVec[proj_i]);
         glDeleteFramebuffers(1, &fboIDVec[proj_i]);
         checkErrorGL(__LINE__, __FILE__);
         glDeleteTextures(1, &fboTextureIDVec[proj_i]);
         checkErrorGL(__LINE__, __FILE__);
     }
+    glDeleteTextures(1, &texWallArrayID);
     ROS_INFO("[SHUTDOWN] Deleted FBO and textures");
 
     // Delete DevIL images
     deleteImgTextures(imgWallIDVec);
     ROS_INFO("[SHUTDOWN] Deleted DevIL images");
 
-    // Destroy GL objects
-    for (int proj_i = 0; proj_i < nProjectors; ++proj_i)
+    // Destroy GL objects, ending with the first headless context that owns the EGL display
+    for (int proj_i = nProjectors - 1; proj_i >= 0; --proj_i)
     {
+        if (!is_glfw)
+        {
+            deleteHeadlessContext(headlessContextVec[proj_i]);
+            continue;
+        }
         glfwDestroyWindow(p_windowIDVec[proj_i]);
         p_windowIDVec[proj_i] = nullptr;
         checkErrorGLFW(__LINE__, __FILE__);
@@ -522,9 +1216,12 @@ int main(int argc, char **argv)
     ROS_INFO("[SHUTDOWN] Shutdown DevIL");
 
     // Terminate GLFW
-    glfwTerminate();
-    checkErrorGLFW(__LINE__, __FILE__);
-    ROS_INFO("[SHUTDOWN] Terminated GLFW");
+    if (is_glfw)
+    {
+        glfwTerminate();
+        checkErrorGLFW(__LINE__, __FILE__);
+        ROS_INFO("[SHUTDOWN] Terminated GLFW");
+    }
 
-    return 0;
+    return is_err_thrown ? -1 : 0;
 }
@@ -0,0 +1,194 @@
+// ##########################################################################################################
+
+// ======================================= projection_homography.cpp =======================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_homography.h"
+
+#include <algorithm>
+#include <cmath>
+
+// SSE is part of the x86-64 baseline, so the batch path needs no runtime dispatch
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HOMOGRAPHY_SSE
+#include <emmintrin.h>
+#endif
+
+// ================================================== VARIABLES ==================================================
+
+// Relative tolerance below which corner turns and h22 are treated as zero by solveHomography4Point()
+static const double HOMOGRAPHY_COLLINEAR_TOL = 1e-9;
+
+// ================================================== FUNCTIONS ==================================================
+
+int homographyFromMat(const cv::Mat &hom_mat, Homography &r_hom)
+{
+    if (hom_mat.rows != 3 || hom_mat.cols != 3 || (hom_mat.type() != CV_32F && hom_mat.type() != CV_64F))
+        return -1;
+
+    for (int row_i = 0; row_i < 3; row_i++)
+        for (int col_i = 0; col_i < 3; col_i++)
+            r_hom.h[row_i * 3 + col_i] = hom_mat.type() == CV_32F ? hom_mat.at<float>(row_i, col_i)
+                                                                  : (float)hom_mat.at<double>(row_i, col_i);
+    return 0;
+}
+
+void homographyToMat(const Homography &hom, cv::Mat &r_hom_mat)
+{
+    r_hom_mat.create(3, 3, CV_32F);
+    for (int row_i = 0; row_i < 3; row_i++)
+        for (int col_i = 0; col_i < 3; col_i++)
+            r_hom_mat.at<float>(row_i, col_i) = hom.h[row_i * 3 + col_i];
+}
+
+/**
+ * @brief Checks that a quad is strictly convex, relative to its squared bounding box size.
+ */
+static bool isQuadConvex(const double *p_xy)
+{
+    // Bounding box diagonal for the scale of the collinearity threshold
+    double x_min = p_xy[0], x_max = p_xy[0], y_min = p_xy[1], y_max = p_xy[1];
+    for (int pt_i = 1; pt_i < 4; pt_i++)
+    {
+        x_min = std::min(x_min, p_xy[pt_i * 2]);
+        x_max = std::max(x_max, p_xy[pt_i * 2]);
+        y_min = std::min(y_min, p_xy[pt_i * 2 + 1]);
+        y_max = std::max(y_max, p_xy[pt_i * 2 + 1]);
+    }
+    double scale_sq = (x_max - x_min) * (x_max - x_min) + (y_max - y_min) * (y_max - y_min);
+    double cross_min = HOMOGRAPHY_COLLINEAR_TOL * scale_sq;
+
+    // Turn direction at every corner must be the same and clearly non-zero
+    int sign_sum = 0;
+    for (int pt_i = 0; pt_i < 4; pt_i++)
+    {
+        const double *p0 = p_xy + pt_i * 2;
+        const double *p1 = p_xy + ((pt_i + 1) % 4) * 2;
+        const double *p2 = p_xy + ((pt_i + 2) % 4) * 2;
+        double cross = (p1[0] - p0[0]) * (p2[1] - p1[1]) - (p1[1] - p0[1]) * (p2[0] - p1[0]);
+        if (!(std::fabs(cross) > cross_min))
+            return false;
+        sign_sum += cross > 0 ? 1 : -1;
+    }
+    return sign_sum == 4 || sign_sum == -4;
+}
+
+/**
+ * @brief Computes the homography mapping the unit square (0,0), (1,0), (1,1), (0,1) onto a quad.
+ */
+static void computeSquareToQuad(const double *p_xy, double *p_h)
+{
+    double x0 = p_xy[0], y0 = p_xy[1], x1 = p_xy[2], y1 = p_xy[3];
+    double x2 = p_xy[4], y2 = p_xy[5], x3 = p_xy[6], y3 = p_xy[7];
+
+    // Projective terms, zero when the quad is a parallelogram. The denominator is non-zero for a convex quad
+    double sx = x0 - x1 + x2 - x3;
+    double sy = y0 - y1 + y2 - y3;
+    double dx1 = x1 - x2, dx2 = x3 - x2, dy1 = y1 - y2, dy2 = y3 - y2;
+    double den = dx1 * dy2 - dx2 * dy1;
+    double g = (sx * dy2 - dx2 * sy) / den;
+    double h = (dx1 * sy - sx * dy1) / den;
+
+    p_h[0] = x1 - x0 + g * x1;
+    p_h[1] = x3 - x0 + h * x3;
+    p_h[2] = x0;
+    p_h[3] = y1 - y0 + g * y1;
+    p_h[4] = y3 - y0 + h * y3;
+    p_h[5] = y0;
+    p_h[6] = g;
+    p_h[7] = h;
+    p_h[8] = 1.0;
+}
+
+int solveHomography4Point(const float *p_src_xy, const float *p_dst_xy, Homography &r_hom)
+{
+    double src_xy[8], dst_xy[8];
+    for (int i = 0; i < 8; i++)
+    {
+        src_xy[i] = p_src_xy[i];
+        dst_xy[i] = p_dst_xy[i];
+    }
+    if (!isQuadConvex(src_xy) || !isQuadConvex(dst_xy))
+        return -1;
+
+    // Square to source and square to destination
+    double s[9], d[9];
+    computeSquareToQuad(src_xy, s);
+    computeSquareToQuad(dst_xy, d);
+
+    // Adjugate of the source mapping, i.e. its inverse up to scale
+    double a[9] = {
+        s[4] * s[8] - s[5] * s[7], s[2] * s[7] - s[1] * s[8], s[1] * s[5] - s[2] * s[4],
+        s[5] * s[6] - s[3] * s[8], s[0] * s[8] - s[2] * s[6], s[2] * s[3] - s[0] * s[5],
+        s[3] * s[7] - s[4] * s[6], s[1] * s[6] - s[0] * s[7], s[0] * s[4] - s[1] * s[3]};
+
+    // Source to square to destination
+    double m[9];
+    double m_max = 0.0;
+    for (int row_i = 0; row_i < 3; row_i++)
+        for (int col_i = 0; col_i < 3; col_i++)
+        {
+            double sum = 0.0;
+            for (int k = 0; k < 3; k++)
+                sum += d[row_i * 3 + k] * a[k * 3 + col_i];
+            m[row_i * 3 + col_i] = sum;
+            m_max = std::max(m_max, std::fabs(sum));
+        }
+
+    // Normalize to h22 = 1 like cv::findHomography()
+    if (!(std::fabs(m[8]) > HOMOGRAPHY_COLLINEAR_TOL * m_max))
+        return -1;
+    Homography hom;
+    for (int i = 0; i < 9; i++)
+    {
+        double val = m[i] / m[8];
+        if (!std::isfinite(val))
+            return -1;
+        hom.h[i] = (float)val;
+    }
+
+    r_hom = hom;
+    return 0;
+}
+
+void transformPoints(const Homography &hom, const float *p_xy_in, float *p_xy_out, size_t n_pts)
+{
+    const std::array<float, 9> &h = hom.h;
+    size_t pt_i = 0;
+
+#ifdef HOMOGRAPHY_SSE
+    const __m128 h00 = _mm_set1_ps(h[0]), h01 = _mm_set1_ps(h[1]), h02 = _mm_set1_ps(h[2]);
+    const __m128 h10 = _mm_set1_ps(h[3]), h11 = _mm_set1_ps(h[4]), h12 = _mm_set1_ps(h[5]);
+    const __m128 h20 = _mm_set1_ps(h[6]), h21 = _mm_set1_ps(h[7]), h22 = _mm_set1_ps(h[8]);
+
+    for (; pt_i + 4 <= n_pts; pt_i += 4)
+    {
+        // Deinterleave x0 y0 x1 y1 | x2 y2 x3 y3 into x0..x3 and y0..y3
+        __m128 xy01 = _mm_loadu_ps(p_xy_in + pt_i * 2);
+        __m128 xy23 = _mm_loadu_ps(p_xy_in + pt_i * 2 + 4);
+        __m128 x = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 y = _mm_shuffle_ps(xy01, xy23, _MM_SHUFFLE(3, 1, 3, 1));
+
+        // Same operation order as the scalar loop below so both give identical results
+        __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(h20, x), _mm_mul_ps(h21, y)), h22);
+        __m128 x_out = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(h00, x), _mm_mul_ps(h01, y)), h02), w);
+        __m128 y_out = _mm_div_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(h10, x), _mm_mul_ps(h11, y)), h12), w);
+
+        // Interleave back and store
+        _mm_storeu_ps(p_xy_out + pt_i * 2, _mm_unpacklo_ps(x_out, y_out));
+        _mm_storeu_ps(p_xy_out + pt_i * 2 + 4, _mm_unpackhi_ps(x_out, y_out));
+    }
+#endif
+
+    for (; pt_i < n_pts; pt_i++)
+    {
+        float x = p_xy_in[pt_i * 2];
+        float y = p_xy_in[pt_i * 2 + 1];
+        float w = h[6] * x + h[7] * y + h[8];
+        p_xy_out[pt_i * 2] = (h[0] * x + h[1] * y + h[2]) / w;
+        p_xy_out[pt_i * 2 + 1] = (h[3] * x + h[4] * y + h[5]) / w;
+    }
+}
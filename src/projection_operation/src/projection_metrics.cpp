@@ -0,0 +1,197 @@
+// ########################################################################################################
+
+// ======================================== projection_metrics.cpp ========================================
+
+// ########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_metrics.h"
+
+#include <algorithm>
+
+// ================================================== VARIABLES ==================================================
+
+// Names of the frame stages used when logging
+static const char *FRAME_STAGE_NAMES[N_FRAME_STAGES] = {
+    "calibration",
+    "geometry",
+    "texture",
+    "draw",
+    "swap",
+    "events",
+};
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Adds a sample to a rolling window, replacing the oldest one once full.
+ */
+static void pushSample(RollingSamples &r_samples, float sample_ms)
+{
+    if (r_samples.sample_vec.size() < METRICS_WINDOW_SIZE)
+    {
+        r_samples.sample_vec.push_back(sample_ms);
+        return;
+    }
+    r_samples.sample_vec[r_samples.next_ind] = sample_ms;
+    r_samples.next_ind = (r_samples.next_ind + 1) % METRICS_WINDOW_SIZE;
+}
+
+/**
+ * @brief Reads back the GPU timer queries whose results are available, oldest first.
+ */
+static void collectGPUTimers(FrameMetrics &r_metrics)
+{
+    while (r_metrics.n_query_pending > 0)
+    {
+        GLuint query_id = r_metrics.query_id_arr[r_metrics.query_read_ind];
+
+        // Stop at the first query the GPU has not finished, later ones cannot be done either
+        GLint is_available = 0;
+        glGetQueryObjectiv(query_id, GL_QUERY_RESULT_AVAILABLE, &is_available);
+        if (!is_available)
+            break;
+
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(query_id, GL_QUERY_RESULT, &elapsed_ns);
+        pushSample(r_metrics.gpu_samples, (float)(elapsed_ns / 1.0e6));
+
+        r_metrics.query_read_ind = (r_metrics.query_read_ind + 1) % N_GPU_TIMER_QUERIES;
+        r_metrics.n_query_pending--;
+    }
+}
+
+void initFrameMetrics(FrameMetrics &r_metrics, const std::string &label_str, bool is_enabled, bool is_gpu)
+{
+    r_metrics.label = label_str;
+    r_metrics.is_enabled = is_enabled;
+    r_metrics.frame_last = std::chrono::steady_clock::now();
+    r_metrics.log_last = r_metrics.frame_last;
+    if (is_enabled && is_gpu)
+        glGenQueries(N_GPU_TIMER_QUERIES, r_metrics.query_id_arr.data());
+}
+
+void deleteFrameMetrics(FrameMetrics &r_metrics)
+{
+    if (r_metrics.query_id_arr[0] != 0)
+        glDeleteQueries(N_GPU_TIMER_QUERIES, r_metrics.query_id_arr.data());
+    r_metrics.query_id_arr.fill(0);
+}
+
+void beginStage(FrameMetrics &r_metrics, FrameStage stage)
+{
+    if (!r_metrics.is_enabled)
+        return;
+    r_metrics.stage_start_arr[stage] = std::chrono::steady_clock::now();
+}
+
+void endStage(FrameMetrics &r_metrics, FrameStage stage)
+{
+    if (!r_metrics.is_enabled)
+        return;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - r_metrics.stage_start_arr[stage];
+    r_metrics.stage_ms_arr[stage] += elapsed.count();
+}
+
+void beginGPUTimer(FrameMetrics &r_metrics)
+{
+    if (!r_metrics.is_enabled || r_metrics.query_id_arr[0] == 0)
+        return;
+
+    // Free up finished queries, and skip this frame rather than wait if the ring is full
+    collectGPUTimers(r_metrics);
+    if (r_metrics.n_query_pending == N_GPU_TIMER_QUERIES)
+        return;
+
+    glBeginQuery(GL_TIME_ELAPSED, r_metrics.query_id_arr[r_metrics.query_write_ind]);
+    r_metrics.is_query_active = true;
+}
+
+void endGPUTimer(FrameMetrics &r_metrics)
+{
+    if (!r_metrics.is_query_active)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    r_metrics.is_query_active = false;
+    r_metrics.query_write_ind = (r_metrics.query_write_ind + 1) % N_GPU_TIMER_QUERIES;
+    r_metrics.n_query_pending++;
+}
+
+void endFrame(FrameMetrics &r_metrics)
+{
+    if (!r_metrics.is_enabled)
+        return;
+
+    // Push the stage times of the frame
+    for (int stage_i = 0; stage_i < N_FRAME_STAGES; stage_i++)
+    {
+        pushSample(r_metrics.stage_samples[stage_i], (float)r_metrics.stage_ms_arr[stage_i]);
+        r_metrics.stage_ms_arr[stage_i] = 0.0;
+    }
+
+    // Push the time since the last frame
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::duration<double, std::milli> frame_ms = now - r_metrics.frame_last;
+    pushSample(r_metrics.frame_samples, (float)frame_ms.count());
+    r_metrics.frame_last = now;
+
+    // Read back the GPU times that are ready
+    if (r_metrics.query_id_arr[0] != 0)
+        collectGPUTimers(r_metrics);
+
+    // Log the summary periodically
+    std::chrono::duration<double> log_elapsed = now - r_metrics.log_last;
+    if (log_elapsed.count() >= METRICS_LOG_INTERVAL_S)
+    {
+        logFrameMetrics(r_metrics);
+        r_metrics.log_last = now;
+    }
+}
+
+void restartFrameInterval(FrameMetrics &r_metrics)
+{
+    if (!r_metrics.is_enabled)
+        return;
+    r_metrics.frame_last = std::chrono::steady_clock::now();
+}
+
+float computePercentile(const RollingSamples &samples, float percentile)
+{
+    if (samples.sample_vec.empty())
+        return 0.0f;
+
+    // Partially sort a copy up to the requested rank
+    std::vector<float> sorted_vec = samples.sample_vec;
+    size_t rank = (size_t)(percentile / 100.0f * (float)(sorted_vec.size() - 1) + 0.5f);
+    std::nth_element(sorted_vec.begin(), sorted_vec.begin() + rank, sorted_vec.end());
+    return sorted_vec[rank];
+}
+
+void logFrameMetrics(const FrameMetrics &metrics)
+{
+    ROS_INFO("[METRICS] %s: Frames[%zu] Frame Interval (ms) p50[%0.3f] p95[%0.3f] p99[%0.3f]",
+             metrics.label.c_str(), metrics.frame_samples.sample_vec.size(),
+             computePercentile(metrics.frame_samples, 50.0f),
+             computePercentile(metrics.frame_samples, 95.0f),
+             computePercentile(metrics.frame_samples, 99.0f));
+
+    for (int stage_i = 0; stage_i < N_FRAME_STAGES; stage_i++)
+    {
+        ROS_INFO("[METRICS] %s: Stage[%s] CPU (ms) p50[%0.3f] p95[%0.3f] p99[%0.3f]",
+                 metrics.label.c_str(), FRAME_STAGE_NAMES[stage_i],
+                 computePercentile(metrics.stage_samples[stage_i], 50.0f),
+                 computePercentile(metrics.stage_samples[stage_i], 95.0f),
+                 computePercentile(metrics.stage_samples[stage_i], 99.0f));
+    }
+
+    if (!metrics.gpu_samples.sample_vec.empty())
+    {
+        ROS_INFO("[METRICS] %s: GPU Draw (ms) p50[%0.3f] p95[%0.3f] p99[%0.3f]",
+                 metrics.label.c_str(),
+                 computePercentile(metrics.gpu_samples, 50.0f),
+                 computePercentile(metrics.gpu_samples, 95.0f),
+                 computePercentile(metrics.gpu_samples, 99.0f));
+    }
+}
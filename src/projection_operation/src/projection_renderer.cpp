@@ -0,0 +1,578 @@
+// #########################################################################################################
+
+// ======================================== projection_renderer.cpp ========================================
+
+// #########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_renderer.h"
+
+// EGL for the headless backend, without the X11 types
+#ifdef HEADLESS_EGL
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+// ================================================== VARIABLES ==================================================
+
+// Synchronous error check flag, on by default only when built with GL_SYNC_CHECKS
+#ifdef GL_SYNC_CHECKS
+bool isGLSyncCheck = true;
+#else
+bool isGLSyncCheck = false;
+#endif
+
+// Calling convention of the OpenGL debug callback (APIENTRY is undefined after the GL headers)
+#ifdef _WIN32
+#define DEBUG_CALLBACK_API __stdcall
+#else
+#define DEBUG_CALLBACK_API
+#endif
+
+// Vertex shader: passes the NDC position through and forwards the texture coordinates
+static const char *VERTEX_SHADER_SRC = R"glsl(
+#version 330 core
+layout(location = 0) in vec2 a_position;
+layout(location = 1) in vec2 a_tex_coord;
+out vec2 v_tex_coord;
+void main()
+{
+    v_tex_coord = a_tex_coord;
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}
+)glsl";
+
+// Fragment shader: samples the wall texture or outputs a solid color
+static const char *FRAGMENT_SHADER_SRC = R"glsl(
+#version 330 core
+in vec2 v_tex_coord;
+uniform sampler2D u_texture;
+uniform bool u_use_texture;
+uniform vec3 u_color;
+out vec4 frag_color;
+void main()
+{
+    if (u_use_texture)
+        frag_color = vec4(texture(u_texture, v_tex_coord).rgb * u_color, 1.0);
+    else
+        frag_color = vec4(u_color, 1.0);
+}
+)glsl";
+
+// Wall vertex shader: picks the instance's corner and texture coordinate from the vertex index
+static const char *WALL_VERTEX_SHADER_SRC = R"glsl(
+#version 330 core
+layout(location = 0) in vec4 a_corners_top;    // top-left x, y and top-right x, y
+layout(location = 1) in vec4 a_corners_bottom; // bottom-right x, y and bottom-left x, y
+layout(location = 2) in int a_layer;           // texture array layer
+out vec3 v_tex_coord;
+void main()
+{
+    vec2 position;
+    vec2 tex_coord;
+    if (gl_VertexID == 0)
+    {
+        position = a_corners_top.xy;
+        tex_coord = vec2(0.0, 1.0);
+    }
+    else if (gl_VertexID == 1)
+    {
+        position = a_corners_top.zw;
+        tex_coord = vec2(1.0, 1.0);
+    }
+    else if (gl_VertexID == 2)
+    {
+        position = a_corners_bottom.xy;
+        tex_coord = vec2(1.0, 0.0);
+    }
+    else
+    {
+        position = a_corners_bottom.zw;
+        tex_coord = vec2(0.0, 0.0);
+    }
+    v_tex_coord = vec3(tex_coord, float(a_layer));
+    gl_Position = vec4(position, 0.0, 1.0);
+}
+)glsl";
+
+// Wall fragment shader: samples the wall image layer
+static const char *WALL_FRAGMENT_SHADER_SRC = R"glsl(
+#version 330 core
+in vec3 v_tex_coord;
+uniform sampler2DArray u_texture_array;
+out vec4 frag_color;
+void main()
+{
+    frag_color = vec4(texture(u_texture_array, v_tex_coord).rgb, 1.0);
+}
+)glsl";
+
+// Overlay fragment shader: samples the base layer and composites the non-white texels of the overlay layers over it
+static const char *OVERLAY_FRAGMENT_SHADER_SRC = R"glsl(
+#version 330 core
+in vec2 v_tex_coord;
+uniform sampler2DArray u_texture_array;
+uniform int u_base_layer;
+uniform int u_overlay_layer[3];
+out vec4 frag_color;
+void main()
+{
+    vec3 color = texture(u_texture_array, vec3(v_tex_coord, float(u_base_layer))).rgb;
+    for (int i = 0; i < 3; i++)
+    {
+        if (u_overlay_layer[i] < 0)
+            continue;
+        vec3 overlay = texture(u_texture_array, vec3(v_tex_coord, float(u_overlay_layer[i]))).rgb;
+        if (any(lessThan(overlay, vec3(254.5 / 255.0))))
+            color = overlay;
+    }
+    frag_color = vec4(color, 1.0);
+}
+)glsl";
+
+// Number of floats per vertex (x, y, u, v)
+static const GLsizei VERTEX_SIZE = 4;
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Compiles a single shader stage and logs the info log on failure.
+ *
+ * @return Shader ID on success, 0 on failure.
+ */
+static GLuint compileShader(GLenum shader_type, const char *p_src)
+{
+    GLuint shader_id = glCreateShader(shader_type);
+    glShaderSource(shader_id, 1, &p_src, NULL);
+    glCompileShader(shader_id);
+
+    GLint status;
+    glGetShaderiv(shader_id, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log_str[1024];
+        glGetShaderInfoLog(shader_id, sizeof(log_str), NULL, log_str);
+        ROS_ERROR("[RENDERER] Shader Compile Failed: Type[%s] Log[%s]", shader_type == GL_VERTEX_SHADER ? "vertex" : "fragment", log_str);
+        glDeleteShader(shader_id);
+        return 0;
+    }
+    return shader_id;
+}
+
+/**
+ * @brief Sets the x, y, u, v attribute layout for the currently bound vertex array and buffer.
+ */
+static void setVertexLayout()
+{
+    GLsizei stride = VERTEX_SIZE * sizeof(GLfloat);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void *)(2 * sizeof(GLfloat)));
+}
+
+/**
+ * @brief Compiles and links a shader program from vertex and fragment sources.
+ *
+ * @return Program ID on success, 0 on failure.
+ */
+static GLuint linkProgram(const char *p_vert_src, const char *p_frag_src)
+{
+    // Compile the shader stages
+    GLuint vert_id = compileShader(GL_VERTEX_SHADER, p_vert_src);
+    GLuint frag_id = compileShader(GL_FRAGMENT_SHADER, p_frag_src);
+    if (vert_id == 0 || frag_id == 0)
+    {
+        glDeleteShader(vert_id);
+        glDeleteShader(frag_id);
+        return 0;
+    }
+
+    // Link the shader program
+    GLuint program_id = glCreateProgram();
+    glAttachShader(program_id, vert_id);
+    glAttachShader(program_id, frag_id);
+    glLinkProgram(program_id);
+    glDeleteShader(vert_id);
+    glDeleteShader(frag_id);
+
+    GLint status;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        char log_str[1024];
+        glGetProgramInfoLog(program_id, sizeof(log_str), NULL, log_str);
+        ROS_ERROR("[RENDERER] Shader Link Failed: Log[%s]", log_str);
+        glDeleteProgram(program_id);
+        return 0;
+    }
+    return program_id;
+}
+
+/**
+ * @brief OpenGL debug message callback that logs the message with ROS.
+ */
+static void DEBUG_CALLBACK_API callbackDebugGL(GLenum source, GLenum type, GLuint id, GLenum severity,
+                                               GLsizei length, const GLchar *p_msg, const void *p_user_param)
+{
+    // Part of the callback signature, the message is null terminated and no user data is installed
+    (void)source;
+    (void)length;
+    (void)p_user_param;
+
+    if (type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH)
+        ROS_ERROR("[OpenGL] Debug Message: ID[%u] Type[0x%X] Severity[0x%X] Message[%s]", id, type, severity, p_msg);
+    else
+        ROS_WARN("[OpenGL] Debug Message: ID[%u] Type[0x%X] Severity[0x%X] Message[%s]", id, type, severity, p_msg);
+}
+
+void setRendererWindowHints()
+{
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+}
+
+int setHeadlessInitHints()
+{
+#ifdef GLFW_PLATFORM_NULL
+    if (!glfwPlatformSupported(GLFW_PLATFORM_NULL))
+    {
+        ROS_ERROR("[RENDERER] Headless Rendering Unavailable: GLFW Built Without the Null Platform");
+        return -1;
+    }
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    return 0;
+#else
+    // Older versions would only give hidden windows, which still need a display server
+    ROS_ERROR("[RENDERER] Headless Rendering Unavailable: GLFW 3.4 or Later or a HEADLESS_EGL Build Required: GLFW[%d.%d]",
+              GLFW_VERSION_MAJOR, GLFW_VERSION_MINOR);
+    return -1;
+#endif
+}
+
+void setHeadlessWindowHints()
+{
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+}
+
+int createHeadlessContext(HeadlessContextEGL &r_context, const HeadlessContextEGL *p_shared_context)
+{
+#ifdef HEADLESS_EGL
+    EGLDisplay display = p_shared_context ? (EGLDisplay)p_shared_context->p_display : EGL_NO_DISPLAY;
+    r_context.is_display_owner = !p_shared_context;
+    if (r_context.is_display_owner)
+    {
+        // Mesa's surfaceless platform needs neither a display server nor a window
+        const char *p_client_ext = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        PFNEGLGETPLATFORMDISPLAYEXTPROC p_get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (!p_client_ext || !std::strstr(p_client_ext, "EGL_MESA_platform_surfaceless") || !p_get_platform_display)
+        {
+            ROS_ERROR("[EGL] Surfaceless Platform Unavailable: Client Extensions[%s]", p_client_ext ? p_client_ext : "");
+            return -1;
+        }
+        display = p_get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+        {
+            ROS_ERROR("[EGL] Failed to Initialize Display: Error[0x%X]", eglGetError());
+            return -1;
+        }
+        ROS_INFO("[EGL] Initialized Surfaceless Display: Version[%d.%d]", major, minor);
+    }
+    r_context.p_display = display;
+
+    // Same core profile as setRendererWindowHints()
+    const EGLint config_attribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    const EGLint context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION, 3,
+                                      EGL_CONTEXT_MINOR_VERSION, 3,
+                                      EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                      EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE,
+                                      EGL_NONE};
+    EGLConfig config;
+    EGLint n_configs = 0;
+    if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, config_attribs, &config, 1, &n_configs) || n_configs < 1)
+    {
+        ROS_ERROR("[EGL] No OpenGL Config: Error[0x%X]", eglGetError());
+        deleteHeadlessContext(r_context);
+        return -1;
+    }
+    EGLContext share_context = p_shared_context ? (EGLContext)p_shared_context->p_context : EGL_NO_CONTEXT;
+    r_context.p_context = eglCreateContext(display, config, share_context, context_attribs);
+    if (r_context.p_context == EGL_NO_CONTEXT)
+    {
+        ROS_ERROR("[EGL] Failed to Create Context: Error[0x%X]", eglGetError());
+        r_context.p_context = nullptr;
+        deleteHeadlessContext(r_context);
+        return -1;
+    }
+    return 0;
+#else
+    (void)r_context;
+    (void)p_shared_context;
+    ROS_ERROR("[EGL] Headless Context Unavailable: Built Without HEADLESS_EGL");
+    return -1;
+#endif
+}
+
+int makeHeadlessContextCurrent(const HeadlessContextEGL &context)
+{
+#ifdef HEADLESS_EGL
+    if (!eglMakeCurrent((EGLDisplay)context.p_display, EGL_NO_SURFACE, EGL_NO_SURFACE, (EGLContext)context.p_context))
+    {
+        ROS_ERROR("[EGL] Failed to Make Context Current: Error[0x%X]", eglGetError());
+        return -1;
+    }
+    return 0;
+#else
+    (void)context;
+    return -1;
+#endif
+}
+
+void deleteHeadlessContext(HeadlessContextEGL &r_context)
+{
+#ifdef HEADLESS_EGL
+    if (!r_context.p_display)
+        return;
+    if (eglGetCurrentContext() == (EGLContext)r_context.p_context)
+        eglMakeCurrent((EGLDisplay)r_context.p_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (r_context.p_context)
+        eglDestroyContext((EGLDisplay)r_context.p_display, (EGLContext)r_context.p_context);
+    if (r_context.is_display_owner)
+        eglTerminate((EGLDisplay)r_context.p_display);
+#endif
+    r_context = HeadlessContextEGL();
+}
+
+void *getHeadlessProcAddress(const char *name)
+{
+#ifdef HEADLESS_EGL
+    return (void *)eglGetProcAddress(name);
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
+
+int initDebugOutput()
+{
+    // Core in OpenGL 4.3, available on older contexts through the extension when glad was generated with it
+    bool is_debug_output = GLAD_GL_VERSION_4_3;
+#ifdef GL_KHR_debug
+    is_debug_output = is_debug_output || GLAD_GL_KHR_debug;
+#endif
+    if (!is_debug_output)
+    {
+        // Without the callback errors are only caught by the glGetError() checks, so turn them on
+        isGLSyncCheck = true;
+        ROS_WARN("[RENDERER] Debug Output Unavailable: OpenGL 4.3 or KHR_debug Required, Synchronous Error Checks Enabled");
+        return -1;
+    }
+
+    glEnable(GL_DEBUG_OUTPUT);
+    if (isGLSyncCheck)
+        glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    else
+        glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(callbackDebugGL, nullptr);
+
+    // Skip informational messages (buffer placement and the like)
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+
+    ROS_INFO("[RENDERER] Debug Output Enabled: Mode[%s]", isGLSyncCheck ? "synchronous" : "asynchronous");
+    return 0;
+}
+
+int initRenderer(RendererGL &r_renderer, const RendererGL *p_shared_renderer)
+{
+    if (p_shared_renderer)
+    {
+        // Reuse the shader programs of the renderer in the shared context
+        r_renderer.program_id = p_shared_renderer->program_id;
+        r_renderer.wall_program_id = p_shared_renderer->wall_program_id;
+        r_renderer.overlay_program_id = p_shared_renderer->overlay_program_id;
+        r_renderer.u_base_layer_loc = p_shared_renderer->u_base_layer_loc;
+        r_renderer.u_overlay_layer_loc = p_shared_renderer->u_overlay_layer_loc;
+        r_renderer.u_color_loc = p_shared_renderer->u_color_loc;
+        r_renderer.u_use_texture_loc = p_shared_renderer->u_use_texture_loc;
+        r_renderer.u_texture_loc = p_shared_renderer->u_texture_loc;
+        r_renderer.is_shared = true;
+    }
+    else
+    {
+        // Build the shader programs
+        r_renderer.program_id = linkProgram(VERTEX_SHADER_SRC, FRAGMENT_SHADER_SRC);
+        r_renderer.wall_program_id = linkProgram(WALL_VERTEX_SHADER_SRC, WALL_FRAGMENT_SHADER_SRC);
+        r_renderer.overlay_program_id = linkProgram(VERTEX_SHADER_SRC, OVERLAY_FRAGMENT_SHADER_SRC);
+        if (r_renderer.program_id == 0 || r_renderer.wall_program_id == 0 || r_renderer.overlay_program_id == 0)
+        {
+            deleteRenderer(r_renderer);
+            return -1;
+        }
+
+        // Get the uniform locations and bind the sampler to texture unit 0
+        r_renderer.u_color_loc = glGetUniformLocation(r_renderer.program_id, "u_color");
+        r_renderer.u_use_texture_loc = glGetUniformLocation(r_renderer.program_id, "u_use_texture");
+        r_renderer.u_texture_loc = glGetUniformLocation(r_renderer.program_id, "u_texture");
+        glUseProgram(r_renderer.program_id);
+        glUniform1i(r_renderer.u_texture_loc, 0);
+        glUseProgram(r_renderer.wall_program_id);
+        glUniform1i(glGetUniformLocation(r_renderer.wall_program_id, "u_texture_array"), 0);
+        r_renderer.u_base_layer_loc = glGetUniformLocation(r_renderer.overlay_program_id, "u_base_layer");
+        r_renderer.u_overlay_layer_loc = glGetUniformLocation(r_renderer.overlay_program_id, "u_overlay_layer");
+        glUseProgram(r_renderer.overlay_program_id);
+        glUniform1i(glGetUniformLocation(r_renderer.overlay_program_id, "u_texture_array"), 0);
+        glUseProgram(0);
+    }
+
+    // Create the streaming vertex array and buffer
+    glGenBuffers(1, &r_renderer.stream_vbo_id);
+    glGenVertexArrays(1, &r_renderer.stream_vao_id);
+    glBindVertexArray(r_renderer.stream_vao_id);
+    glBindBuffer(GL_ARRAY_BUFFER, r_renderer.stream_vbo_id);
+    setVertexLayout();
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Check for GL errors
+    GLenum gl_err = glGetError();
+    if (gl_err != GL_NO_ERROR)
+    {
+        ROS_ERROR("[RENDERER] Initialization Failed: Error Number[%u]", gl_err);
+        deleteRenderer(r_renderer);
+        return -1;
+    }
+
+    ROS_INFO("[RENDERER] Initialized: GLSL Version[%s] Shared[%s]", glGetString(GL_SHADING_LANGUAGE_VERSION), r_renderer.is_shared ? "true" : "false");
+    return 0;
+}
+
+void deleteRenderer(RendererGL &r_renderer)
+{
+    // Shared programs are deleted by the renderer that built them
+    if (!r_renderer.is_shared)
+    {
+        glDeleteProgram(r_renderer.program_id);
+        glDeleteProgram(r_renderer.wall_program_id);
+        glDeleteProgram(r_renderer.overlay_program_id);
+    }
+    glDeleteVertexArrays(1, &r_renderer.stream_vao_id);
+    glDeleteBuffers(1, &r_renderer.stream_vbo_id);
+    r_renderer = RendererGL();
+}
+
+int createWallVertexArray(GLuint geometry_vbo_id, GLuint layer_vbo_id, GLuint &r_vao_id)
+{
+    // Generate the vertex array on first use
+    if (r_vao_id == 0)
+    {
+        glGenVertexArrays(1, &r_vao_id);
+    }
+    glBindVertexArray(r_vao_id);
+
+    // Wall corners, advanced once per instance
+    GLsizei stride = 8 * sizeof(GLfloat);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry_vbo_id);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    glVertexAttribDivisor(0, 1);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void *)(4 * sizeof(GLfloat)));
+    glVertexAttribDivisor(1, 1);
+
+    // Texture array layer, advanced once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, layer_vbo_id);
+    glEnableVertexAttribArray(2);
+    glVertexAttribIPointer(2, 1, GL_INT, sizeof(GLint), (void *)0);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Check for GL errors
+    GLenum gl_err = glGetError();
+    if (gl_err != GL_NO_ERROR)
+    {
+        ROS_ERROR("[RENDERER] Failed to Create Wall Vertex Array: Error Number[%u]", gl_err);
+        return -1;
+    }
+    return 0;
+}
+
+void drawWallsInstanced(RendererGL &r_renderer, GLuint vao_id, GLsizei n_walls, GLuint texture_array_id)
+{
+    glUseProgram(r_renderer.wall_program_id);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_array_id);
+
+    // Each instance is one wall drawn as a 4 vertex fan
+    glBindVertexArray(vao_id);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, n_walls);
+    glBindVertexArray(0);
+}
+
+void drawStreamTextured(RendererGL &r_renderer, const GLfloat *p_vertices, GLsizei n_vertices, GLuint texture_id)
+{
+    // Orphan and refill the streaming buffer
+    glBindBuffer(GL_ARRAY_BUFFER, r_renderer.stream_vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, n_vertices * VERTEX_SIZE * sizeof(GLfloat), p_vertices, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(r_renderer.program_id);
+    glUniform1i(r_renderer.u_use_texture_loc, 1);
+    glUniform3f(r_renderer.u_color_loc, 1.0f, 1.0f, 1.0f);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+
+    glBindVertexArray(r_renderer.stream_vao_id);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, n_vertices);
+    glBindVertexArray(0);
+}
+
+void drawStreamLayered(RendererGL &r_renderer, const GLfloat *p_vertices, GLsizei n_vertices, GLuint texture_array_id,
+                       GLint base_layer, const std::array<GLint, N_OVERLAY_LAYERS> &overlay_layer_arr)
+{
+    // Orphan and refill the streaming buffer
+    glBindBuffer(GL_ARRAY_BUFFER, r_renderer.stream_vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, n_vertices * VERTEX_SIZE * sizeof(GLfloat), p_vertices, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(r_renderer.overlay_program_id);
+    glUniform1i(r_renderer.u_base_layer_loc, base_layer);
+    glUniform1iv(r_renderer.u_overlay_layer_loc, N_OVERLAY_LAYERS, overlay_layer_arr.data());
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_array_id);
+
+    glBindVertexArray(r_renderer.stream_vao_id);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, n_vertices);
+    glBindVertexArray(0);
+}
+
+void drawStreamColored(RendererGL &r_renderer, const GLfloat *p_vertices, GLsizei n_vertices, const std::vector<float> &rgb_vec)
+{
+    // Orphan and refill the streaming buffer
+    glBindBuffer(GL_ARRAY_BUFFER, r_renderer.stream_vbo_id);
+    glBufferData(GL_ARRAY_BUFFER, n_vertices * VERTEX_SIZE * sizeof(GLfloat), p_vertices, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(r_renderer.program_id);
+    glUniform1i(r_renderer.u_use_texture_loc, 0);
+    glUniform3f(r_renderer.u_color_loc, rgb_vec[0], rgb_vec[1], rgb_vec[2]);
+
+    glBindVertexArray(r_renderer.stream_vao_id);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, n_vertices);
+    glBindVertexArray(0);
+}
@@ -118,7 +118,8 @@ int loadCoordinatesXML(cv::Mat &r_hom_mat, std::array<std::array<float, 6>, 4> &
         }
     }
 
-    // Copy data from temporary array to reference matrix
+    // Copy data from temporary array to reference matrix, allocating it if the caller passed an empty one
+    r_hom_mat.create(3, 3, CV_32F);
     for (int i = 0; i < 3; i++)
     {
         for (int j = 0; j < 3; j++)
@@ -170,7 +171,7 @@ int loadCoordinatesXML(cv::Mat &r_hom_mat, std::array<std::array<float, 6>, 4> &
     return 0;
 }
 
-void saveCoordinatesXML(cv::Mat hom_mat, std::array<std::array<float, 6>, 4> ctrl_point_params, std::string full_path)
+int saveCoordinatesXML(cv::Mat hom_mat, std::array<std::array<float, 6>, 4> ctrl_point_params, std::string full_path)
 {
     // Create an XML document object
     pugi::xml_document doc;
@@ -229,15 +230,197 @@ void saveCoordinatesXML(cv::Mat hom_mat, std::array<std::array<float, 6>, 4> ctr
     // Get file name from path
     std::string file_name = full_path.substr(full_path.find_last_of('/') + 1);
 
-    // Save the XML document to a file specified by 'configPath'
-    if (doc.save_file(full_path.c_str()))
+    // Save to a temporary file and rename it over the old one so a failed save never truncates it
+    std::string tmp_path = full_path + ".tmp";
+    if (!doc.save_file(tmp_path.c_str()) || replaceFile(tmp_path, full_path) != 0)
     {
-        ROS_INFO("[SAVE XML] File Saved Successfully: File[%s]", file_name.c_str());
+        ROS_ERROR("[SAVE XML] Failed to Save XML: File[%s]", file_name.c_str());
+        std::remove(tmp_path.c_str());
+        return -1;
     }
-    else
+
+    ROS_INFO("[SAVE XML] File Saved Successfully: File[%s]", file_name.c_str());
+    return 0;
+}
+
+int loadCalibrationParams(int mon_id_ind, std::string config_dir_path, int grid_size, std::array<CalibrationParams, N_CAL_MODES> &r_cal_params_arr)
+{
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
     {
-        ROS_ERROR("[SAVE XML] Failed to Save XML: File[%s]", file_name.c_str());
+        CalibrationParams &r_cal_params = r_cal_params_arr[cal_i];
+
+        // Load the image transform coordinates from the XML file
+        std::string file_path = formatCoordinatesFilePathXML(mon_id_ind, cal_i, config_dir_path);
+        if (loadCoordinatesXML(r_cal_params.hom_mat, r_cal_params.ctrl_point_params, file_path, 0) != 0)
+        {
+            ROS_ERROR("[LOAD XML] Missing XML File[%s]", file_path.c_str());
+            return -1;
+        }
+
+        // Recompute the homography from the control points, the stored one is not trusted
+        if (computeHomography(r_cal_params.hom_mat, r_cal_params.ctrl_point_params) != 0)
+        {
+            ROS_ERROR("[LOAD XML] Degenerate Control Points: File[%s]", file_path.c_str());
+            return -1;
+        }
+
+        // Interpolate the wall parameters once for the render loop
+        computeWallParamField(r_cal_params.ctrl_point_params, grid_size, r_cal_params.param_field);
+    }
+
+    ROS_INFO("[LOAD XML] Loaded Calibration: Monitor[%d] Modes[%d]", mon_id_ind, N_CAL_MODES);
+    return 0;
+}
+
+int loadCalibrationParams(const MappedCalibrationBundle &bundle, int mon_id_ind, int grid_size, std::array<CalibrationParams, N_CAL_MODES> &r_cal_params_arr)
+{
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+    {
+        const CalibrationBundleEntry *p_entry = findCalibrationBundleEntry(bundle, mon_id_ind, cal_i);
+        if (!p_entry)
+        {
+            ROS_WARN("[LOAD BUNDLE] Missing Calibration: Monitor[%d] Mode[%d]", mon_id_ind, cal_i);
+            return -1;
+        }
+        CalibrationParams &r_cal_params = r_cal_params_arr[cal_i];
+
+        // Copy the parameters out of the mapping, the bundle stores them in their in-memory layout
+        for (int cp_i = 0; cp_i < 4; cp_i++)
+            std::copy(p_entry->ctrl_point_params[cp_i], p_entry->ctrl_point_params[cp_i] + 6, r_cal_params.ctrl_point_params[cp_i].begin());
+        Homography hom;
+        std::copy(p_entry->hom, p_entry->hom + 9, hom.h.begin());
+        homographyToMat(hom, r_cal_params.hom_mat);
+
+        // Interpolate the wall parameters once for the render loop
+        computeWallParamField(r_cal_params.ctrl_point_params, grid_size, r_cal_params.param_field);
+    }
+
+    ROS_INFO("[LOAD BUNDLE] Loaded Calibration: Monitor[%d] Modes[%d]", mon_id_ind, N_CAL_MODES);
+    return 0;
+}
+
+int convertCalibrationXMLToBundle(std::string config_dir_path, std::string bundle_path)
+{
+    std::vector<CalibrationBundleEntry> entry_vec;
+    for (int mon_i = 0; mon_i < N_CAL_BUNDLE_MON; mon_i++)
+    {
+        // Skip monitors without a calibration, only report ones with some modes missing
+        int n_found = 0;
+        for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+            n_found += std::ifstream(formatCoordinatesFilePathXML(mon_i, cal_i, config_dir_path)).good() ? 1 : 0;
+        if (n_found == 0)
+            continue;
+        if (n_found != N_CAL_MODES)
+        {
+            ROS_WARN("[CONVERT] Skipping Incomplete Calibration: Monitor[%d] Modes[%d/%d]", mon_i, n_found, N_CAL_MODES);
+            continue;
+        }
+
+        for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+        {
+            std::string file_path = formatCoordinatesFilePathXML(mon_i, cal_i, config_dir_path);
+            std::array<std::array<float, 6>, 4> ctrl_point_params;
+            cv::Mat hom_mat = cv::Mat::eye(3, 3, CV_32F);
+            Homography hom;
+            if (loadCoordinatesXML(hom_mat, ctrl_point_params, file_path, 0) != 0 ||
+                computeHomography(hom_mat, ctrl_point_params) != 0 ||
+                homographyFromMat(hom_mat, hom) != 0)
+            {
+                ROS_ERROR("[CONVERT] Invalid Calibration: File[%s]", file_path.c_str());
+                return -1;
+            }
+
+            CalibrationBundleEntry entry;
+            entry.mon_ind = mon_i;
+            entry.cal_ind = cal_i;
+            for (int cp_i = 0; cp_i < 4; cp_i++)
+                std::copy(ctrl_point_params[cp_i].begin(), ctrl_point_params[cp_i].end(), entry.ctrl_point_params[cp_i]);
+            std::copy(hom.h.begin(), hom.h.end(), entry.hom);
+            entry_vec.push_back(entry);
+        }
+    }
+
+    if (entry_vec.empty())
+    {
+        ROS_ERROR("[CONVERT] No Calibration XML Files Found: Directory[%s]", config_dir_path.c_str());
+        return -1;
+    }
+    return writeCalibrationBundle(bundle_path, entry_vec);
+}
+
+int convertCalibrationBundleToXML(std::string bundle_path, std::string config_dir_path)
+{
+    MappedCalibrationBundle bundle;
+    if (openCalibrationBundle(bundle_path, bundle) != 0)
+        return -1;
+
+    for (size_t entry_i = 0; entry_i < bundle.n_entries; entry_i++)
+    {
+        const CalibrationBundleEntry &entry = bundle.p_entries[entry_i];
+        std::array<std::array<float, 6>, 4> ctrl_point_params;
+        for (int cp_i = 0; cp_i < 4; cp_i++)
+            std::copy(entry.ctrl_point_params[cp_i], entry.ctrl_point_params[cp_i] + 6, ctrl_point_params[cp_i].begin());
+        Homography hom;
+        std::copy(entry.hom, entry.hom + 9, hom.h.begin());
+        cv::Mat hom_mat;
+        homographyToMat(hom, hom_mat);
+
+        if (saveCoordinatesXML(hom_mat, ctrl_point_params, formatCoordinatesFilePathXML(entry.mon_ind, entry.cal_ind, config_dir_path)) != 0)
+        {
+            closeCalibrationBundle(bundle);
+            return -1;
+        }
+    }
+
+    ROS_INFO("[CONVERT] Wrote Calibration XML Files: Entries[%zu] Directory[%s]", bundle.n_entries, config_dir_path.c_str());
+    closeCalibrationBundle(bundle);
+    return 0;
+}
+
+void packCalibrationMsg(int mon_id_ind, int mode_cal_ind, const std::array<std::array<float, 6>, 4> &ctrl_point_params, const cv::Mat &hom_mat, std::vector<float> &r_data_vec)
+{
+    Homography hom = HOMOGRAPHY_IDENTITY;
+    homographyFromMat(hom_mat, hom);
+
+    r_data_vec.clear();
+    r_data_vec.reserve(CAL_LIVE_MSG_SIZE);
+    r_data_vec.push_back((float)mon_id_ind);
+    r_data_vec.push_back((float)mode_cal_ind);
+    for (const auto &row : ctrl_point_params)
+        r_data_vec.insert(r_data_vec.end(), row.begin(), row.end());
+    r_data_vec.insert(r_data_vec.end(), hom.h.begin(), hom.h.end());
+}
+
+int unpackCalibrationMsg(const std::vector<float> &data_vec, int &r_mon_id_ind, int &r_mode_cal_ind, std::array<std::array<float, 6>, 4> &r_ctrl_point_params, cv::Mat &r_hom_mat)
+{
+    if ((int)data_vec.size() != CAL_LIVE_MSG_SIZE)
+    {
+        ROS_WARN("[LIVE] Invalid Calibration Message Size: Size[%zu] Expected[%d]", data_vec.size(), CAL_LIVE_MSG_SIZE);
+        return -1;
+    }
+    for (float val : data_vec)
+    {
+        if (!std::isfinite(val))
+        {
+            ROS_WARN("[LIVE] Calibration Message Has Non-Finite Values");
+            return -1;
+        }
+    }
+    if (data_vec[0] < 0.0f || data_vec[0] >= (float)N_CAL_BUNDLE_MON || data_vec[1] < 0.0f || data_vec[1] >= (float)N_CAL_MODES)
+    {
+        ROS_WARN("[LIVE] Invalid Calibration Message Indices: Monitor[%0.0f] Mode[%0.0f]", data_vec[0], data_vec[1]);
+        return -1;
     }
+
+    r_mon_id_ind = (int)data_vec[0];
+    r_mode_cal_ind = (int)data_vec[1];
+    for (int cp_i = 0; cp_i < 4; cp_i++)
+        std::copy(data_vec.begin() + 2 + cp_i * 6, data_vec.begin() + 2 + (cp_i + 1) * 6, r_ctrl_point_params[cp_i].begin());
+    Homography hom;
+    std::copy(data_vec.begin() + 2 + 4 * 6, data_vec.end(), hom.h.begin());
+    r_hom_mat = cv::Mat(); // Never write into a matrix that may share its data with a copy
+    homographyToMat(hom, r_hom_mat);
+    return 0;
 }
 
 int loadImgTextures(std::vector<std::string> img_paths_vec, std::vector<ILuint> &r_image_id_vec)
@@ -352,9 +535,80 @@ int deleteImgTextures(std::vector<ILuint> &r_image_id_vec)
     return status;
 }
 
+int loadGLTextureArray(std::vector<ILuint> image_id_vec, GLuint &r_texture_array_id)
+{
+    int n_img = (int)image_id_vec.size();
+    char msg_str[128];
+
+    if (n_img == 0)
+    {
+        ROS_ERROR("[OpenGL] No Images to Load into Texture Array");
+        return -1;
+    }
+
+    // Get the layer size from the first image
+    ilBindImage(image_id_vec[0]);
+    int width = ilGetInteger(IL_IMAGE_WIDTH);
+    int height = ilGetInteger(IL_IMAGE_HEIGHT);
+
+    // Generate the texture array and allocate storage for all the layers
+    glGenTextures(1, &r_texture_array_id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, r_texture_array_id);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, n_img, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    // Use linear filtering without mipmaps and clamp at the wall edges
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Rows of the RGB images are not guaranteed to be 4 byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // Upload each image into its layer once
+    for (int img_i = 0; img_i < n_img; img_i++)
+    {
+        ILuint img_id = image_id_vec[img_i];
+
+        // Bind image
+        ilBindImage(img_id);
+        snprintf(msg_str, sizeof(msg_str), "Failed to Bind Image: Ind[%d/%d] ID[%u]", img_i, n_img - 1, img_id);
+        if (checkErrorDevIL(__LINE__, __FILE__, msg_str) != 0)
+        {
+            return -1;
+        }
+
+        // Check the image matches the layer size
+        if (ilGetInteger(IL_IMAGE_WIDTH) != width || ilGetInteger(IL_IMAGE_HEIGHT) != height)
+        {
+            ROS_ERROR("[OpenGL] Texture Array Image is Wrong Size: Ind[%d/%d] ID[%u] Size Actual[%d,%d] Size Expected[%d,%d]",
+                      img_i, n_img - 1, img_id, ilGetInteger(IL_IMAGE_WIDTH), ilGetInteger(IL_IMAGE_HEIGHT), width, height);
+            return -1;
+        }
+
+        // Upload the image data
+        GLenum format = ilGetInteger(IL_IMAGE_FORMAT) == IL_RGBA ? GL_RGBA : GL_RGB;
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, img_i, width, height, 1, format, GL_UNSIGNED_BYTE, ilGetData());
+    }
+
+    // Unbind the texture array
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    // Check for GL errors
+    GLenum gl_err = glGetError();
+    if (gl_err != GL_NO_ERROR)
+    {
+        ROS_ERROR("[OpenGL] Failed to Create Texture Array: Layers[%d] Error Number[%u]", n_img, gl_err);
+        return -1;
+    }
+
+    ROS_INFO("[OpenGL] Created Texture Array: Layers[%d] Size[%d,%d]", n_img, width, height);
+    return 0;
+}
+
 int mergeImages(ILuint img1_id, ILuint img2_id, ILuint &r_img_merge_id)
 {
-    // Bind and get dimensions of img1 (baseline image)
+    // Bind and get dimensions and format of img1 (baseline image)
     ilBindImage(img1_id);
     if (checkErrorDevIL(__LINE__, __FILE__, "Binding Image1") != 0)
     {
@@ -363,8 +617,23 @@ int mergeImages(ILuint img1_id, ILuint img2_id, ILuint &r_img_merge_id)
     }
     int width1 = ilGetInteger(IL_IMAGE_WIDTH);
     int height1 = ilGetInteger(IL_IMAGE_HEIGHT);
+    ILenum format1 = ilGetInteger(IL_IMAGE_FORMAT);
     ILubyte *data1 = ilGetData();
 
+    // Map the DevIL format to the compositing pixel format
+    PixelFormat pxl_format;
+    if (format1 == IL_RGB)
+        pxl_format = PIXEL_RGB;
+    else if (format1 == IL_BGR)
+        pxl_format = PIXEL_BGR;
+    else if (format1 == IL_RGBA)
+        pxl_format = PIXEL_RGBA;
+    else
+    {
+        ROS_ERROR("[MERGE IMAGE] Image1 is Not IL_RGB, IL_BGR or IL_RGBA: ID[%u] Format[0x%X]", img1_id, format1);
+        return -1;
+    }
+
     // Bind and get dimensions of img2 (mask image)
     ilBindImage(img2_id);
     if (checkErrorDevIL(__LINE__, __FILE__, "Binding Image2") != 0)
@@ -374,7 +643,6 @@ int mergeImages(ILuint img1_id, ILuint img2_id, ILuint &r_img_merge_id)
     }
     int width2 = ilGetInteger(IL_IMAGE_WIDTH);
     int height2 = ilGetInteger(IL_IMAGE_HEIGHT);
-    ILubyte *data2 = ilGetData();
 
     // Check for dimension match
     if (width1 != width2 || height1 != height2)
@@ -384,76 +652,87 @@ int mergeImages(ILuint img1_id, ILuint img2_id, ILuint &r_img_merge_id)
         return -1;
     }
 
-    // Create merged image
+    // Convert a copy of img2 if its format differs so the caller's image is left unchanged
+    ILuint img2_conv_id = 0;
+    if ((ILenum)ilGetInteger(IL_IMAGE_FORMAT) != format1)
+    {
+        img2_conv_id = ilCloneCurImage();
+        ilBindImage(img2_conv_id);
+        ilConvertImage(format1, IL_UNSIGNED_BYTE);
+        if (checkErrorDevIL(__LINE__, __FILE__, "Converting Image2") != 0)
+        {
+            ROS_ERROR("[MERGE IMAGE] Error Converting Image2: ID[%u]", img2_id);
+            ilDeleteImages(1, &img2_conv_id);
+            return -1;
+        }
+    }
+    ILubyte *data2 = ilGetData();
+
+    // Create merged image in the format of img1
     ilGenImages(1, &r_img_merge_id);
     ilBindImage(r_img_merge_id);
-    ilTexImage(width1, height1, 1, 4, IL_RGBA, IL_UNSIGNED_BYTE, NULL);
+    ilTexImage(width1, height1, 1, getPixelSize(pxl_format), format1, IL_UNSIGNED_BYTE, NULL);
     if (checkErrorDevIL(__LINE__, __FILE__, "Creating Merged Image") != 0)
     {
         ROS_ERROR("[MERGE IMAGE] Error Creating Merged Image: ID[%u]", r_img_merge_id);
+        if (img2_conv_id != 0)
+            ilDeleteImages(1, &img2_conv_id);
         return -1;
     }
-
-    // Specify number of pixels x color channels in the image
-    int n_pxl_rbga = width1 * height1 * 4;
-
-    // Initialize merged_img_data vector
-    std::vector<ILubyte> merged_img_data;
-    merged_img_data.resize(n_pxl_rbga);
+    ILubyte *data_merge = ilGetData();
 
     // Check for null pointers or zero dimensions
-    if (!data1 || !data2 || merged_img_data.empty())
-    {
-        ROS_ERROR("[MERGE IMAGE] Null data pointer detected.");
-        if (!data1)
-            ROS_ERROR("[MERGE IMAGE] data1 is null.");
-        if (!data2)
-            ROS_ERROR("[MERGE IMAGE] data2 is null.");
-        if (n_pxl_rbga == 0)
-            ROS_ERROR("[MERGE IMAGE] n_pxl_rbga is zero.");
-        return -1;
-    }
-
-    static bool t1 = true;
-    if (t1)
+    size_t n_pxl = (size_t)width1 * (size_t)height1;
+    if (!data1 || !data2 || !data_merge || n_pxl == 0)
     {
-        t1 = false;
-        ROS_INFO("TEST1");
+        ROS_ERROR("[MERGE IMAGE] Null Data Pointer or Empty Image: Image1: ID[%u]; Image2: ID[%u]; Pixels[%zu]",
+                  img1_id, img2_id, n_pxl);
+        if (img2_conv_id != 0)
+            ilDeleteImages(1, &img2_conv_id);
+        return -1;
     }
 
-    // Loop to overlay non-white pixels from img2 onto img1
-    for (int i = 0; i < n_pxl_rbga; i += 4)
+    // Overlay non-white pixels from img2 onto img1 directly into the merged image
+    int status = compositeImages(data1, data2, data_merge, n_pxl, pxl_format, COMPOSITE_COLOR_KEY);
+    if (img2_conv_id != 0)
+        ilDeleteImages(1, &img2_conv_id);
+    if (status != 0)
     {
-        if (data2[i] != 255 || data2[i + 1] != 255 || data2[i + 2] != 255)
-        {
-            for (int j = 0; j < 4; ++j)
-                merged_img_data[i + j] = data2[i + j];
-        }
-        else
-        {
-            for (int j = 0; j < 4; ++j)
-                merged_img_data[i + j] = data1[i + j];
-        }
+        ROS_ERROR("[MERGE IMAGE] Error Compositing Images: Image1: ID[%u]; Image2: ID[%u]", img1_id, img2_id);
+        return -1;
     }
 
-    static bool t2 = true;
-    if (t2)
-    {
-        t2 = false;
-        ROS_INFO("TEST2");
-    }
+    return 0;
+}
 
-    // Set merge image data to the new image
-    ilBindImage(r_img_merge_id);
-    ilSetPixels(0, 0, 0, width1, height1, 1, IL_RGBA, IL_UNSIGNED_BYTE, merged_img_data.data());
-    if (checkErrorDevIL(__LINE__, __FILE__, "Setting Pixels for Merged Image") != 0)
+int diffImages(const cv::Mat &frame_mat, const cv::Mat &ref_mat, int tolerance, cv::Mat &r_heatmap_mat)
+{
+    // Check the images can be compared
+    if (frame_mat.size() != ref_mat.size() || frame_mat.type() != ref_mat.type())
     {
-        ROS_ERROR("[MERGE IMAGE] Error Setting Pixels for Merged Image: ID[%u]", r_img_merge_id);
+        ROS_ERROR("[DIFF] Image Mismatch: Frame Size[%dx%d] Type[%d] Reference Size[%dx%d] Type[%d]",
+                  frame_mat.cols, frame_mat.rows, frame_mat.type(), ref_mat.cols, ref_mat.rows, ref_mat.type());
         return -1;
     }
 
-    // No need for manual delete[] here, as we used std::vector
-    return 0;
+    // Get the largest per-channel absolute difference of each pixel
+    cv::Mat diff_mat;
+    cv::absdiff(frame_mat, ref_mat, diff_mat);
+    cv::Mat max_diff_mat = diff_mat.reshape(1, (int)diff_mat.total());
+    cv::reduce(max_diff_mat, max_diff_mat, 1, cv::REDUCE_MAX);
+    max_diff_mat = max_diff_mat.reshape(1, frame_mat.rows);
+
+    // Count the pixels outside the tolerance
+    cv::Mat bad_mask_mat;
+    cv::threshold(max_diff_mat, bad_mask_mat, tolerance, 255, cv::THRESH_BINARY);
+    int n_bad_pxl = cv::countNonZero(bad_mask_mat);
+
+    // Color the differences, scaled so the tolerance maps to the middle of the color map
+    cv::Mat scaled_mat;
+    max_diff_mat.convertTo(scaled_mat, CV_8U, 128.0 / std::max(tolerance, 1));
+    cv::applyColorMap(scaled_mat, r_heatmap_mat, cv::COLORMAP_JET);
+
+    return n_bad_pxl;
 }
 
 float bilinearInterpolation(std::array<std::array<float, 6>, 4> ctrl_point_params, int ctrl_point_params_ind, int grid_row_i, int grid_col_i, int grid_size, bool do_offset)
@@ -509,6 +788,56 @@ float bilinearInterpolationFull(std::array<std::array<float, 6>, 4> ctrl_point_p
     return interp_val;
 }
 
+void computeWallParamField(const std::array<std::array<float, 6>, 4> &ctrl_point_params, int grid_size, WallParamField &r_param_field)
+{
+    const int n_cells = grid_size * grid_size;
+    r_param_field.grid_size = grid_size;
+    r_param_field.wall_space_x = originPlaneWidth / (float(grid_size) - 1);
+    r_param_field.wall_space_y = originPlaneHeight / (float(grid_size) - 1);
+    r_param_field.width_vec.resize(n_cells);
+    r_param_field.height_vec.resize(n_cells);
+    r_param_field.shear_x_vec.resize(n_cells);
+    r_param_field.shear_y_vec.resize(n_cells);
+
+    // Grid corner values of the 4 wall parameters, same mapping as bilinearInterpolationFull()
+    float corner_arr[4][4]; // [param][A, B, C, D]
+    for (int param_i = 0; param_i < 4; param_i++)
+    {
+        corner_arr[param_i][0] = ctrl_point_params[3][param_i + 2]; // row[0] col[0]
+        corner_arr[param_i][1] = ctrl_point_params[2][param_i + 2]; // row[0] col[s-1]
+        corner_arr[param_i][2] = ctrl_point_params[0][param_i + 2]; // row[s-1] col[0]
+        corner_arr[param_i][3] = ctrl_point_params[1][param_i + 2]; // row[s-1] col[s-1]
+    }
+    float *p_out_arr[4] = {r_param_field.width_vec.data(), r_param_field.height_vec.data(),
+                           r_param_field.shear_x_vec.data(), r_param_field.shear_y_vec.data()};
+
+    // Relative column positions, shared by every row
+    std::vector<float> x_vec(grid_size);
+    for (int grid_col_i = 0; grid_col_i < grid_size; grid_col_i++)
+        x_vec[grid_col_i] = static_cast<float>(grid_col_i) / (grid_size - 1);
+
+    for (int grid_row_i = 0; grid_row_i < grid_size; grid_row_i++)
+    {
+        float y = static_cast<float>(grid_row_i) / (grid_size - 1);
+        for (int param_i = 0; param_i < 4; param_i++)
+        {
+            const float A = corner_arr[param_i][0], B = corner_arr[param_i][1];
+            const float C = corner_arr[param_i][2], D = corner_arr[param_i][3];
+            float *p_out = p_out_arr[param_i] + grid_row_i * grid_size;
+
+            // Same expression as bilinearInterpolationFull() so the values match exactly
+            for (int grid_col_i = 0; grid_col_i < grid_size; grid_col_i++)
+            {
+                float x = x_vec[grid_col_i];
+                p_out[grid_col_i] = (1 - x) * (1 - y) * A +
+                                    x * (1 - y) * B +
+                                    (1 - x) * y * C +
+                                    x * y * D;
+            }
+        }
+    }
+}
+
 // std::vector<cv::Point2f> computeQuadVertices(float x0, float y0, float width, float height, float shear_x, float shear_y)
 // {
 //     std::vector<cv::Point2f> quad_vertices_vec;
@@ -530,72 +859,118 @@ float bilinearInterpolationFull(std::array<std::array<float, 6>, 4> ctrl_point_p
 
 std::vector<cv::Point2f> computeQuadVertices(float x0, float y0, float width, float height, float shear_x, float shear_y)
 {
-    std::vector<cv::Point2f> quad_vertices_vec;
+    std::vector<cv::Point2f> quad_vertices_vec(4);
+    computeQuadVertices(x0, y0, width, height, shear_x, shear_y, reinterpret_cast<float *>(quad_vertices_vec.data()));
+    return quad_vertices_vec;
+}
 
+void computeQuadVertices(float x0, float y0, float width, float height, float shear_x, float shear_y, float *p_xy_out)
+{
     // Top-left vertex after applying shear
-    quad_vertices_vec.push_back(cv::Point2f(x0 + height * shear_x, y0 + height));
+    p_xy_out[0] = x0 + height * shear_x;
+    p_xy_out[1] = y0 + height;
 
     // Top-right vertex after applying shear
-    quad_vertices_vec.push_back(cv::Point2f(x0 + height * shear_x + width, y0 + height + width * shear_y));
+    p_xy_out[2] = x0 + height * shear_x + width;
+    p_xy_out[3] = y0 + height + width * shear_y;
 
     // Bottom-right vertex
-    quad_vertices_vec.push_back(cv::Point2f(x0 + width, y0 + width * shear_y));
+    p_xy_out[4] = x0 + width;
+    p_xy_out[5] = y0 + width * shear_y;
 
     // Bottom-left vertex
-    quad_vertices_vec.push_back(cv::Point2f(x0, y0));
-
-    return quad_vertices_vec;
+    p_xy_out[6] = x0;
+    p_xy_out[7] = y0;
 }
 
-void computeHomography(cv::Mat &r_hom_mat, std::array<std::array<float, 6>, 4> ctrl_point_params)
+int computeHomography(cv::Mat &r_hom_mat, std::array<std::array<float, 6>, 4> ctrl_point_params)
 {
     // Calculate the vertices for the control point boundary dimensions.
     // These vertices will be used as points for the 'origin' or source' when computing the homography matrix.
-    std::vector<cv::Point2f> origin_plane_vertices;
-    origin_plane_vertices = computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f);
+    float origin_plane_xy[8];
+    computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f, origin_plane_xy);
 
-    // Create a vector containing teh x and y cordinates of the 4 control points, whoe's origin is the center of the image.
+    // Create an array containing the x and y cordinates of the 4 control points, whoe's origin is the center of the image.
     // These vertices will be used as points for the 'target' or 'destination' plane when computing the homography matrix.
-    std::vector<cv::Point2f> target_plane_vertices;
-    target_plane_vertices.push_back(cv::Point2f(ctrl_point_params[0][0], ctrl_point_params[0][1])); // top-left
-    target_plane_vertices.push_back(cv::Point2f(ctrl_point_params[1][0], ctrl_point_params[1][1])); // top-right
-    target_plane_vertices.push_back(cv::Point2f(ctrl_point_params[2][0], ctrl_point_params[2][1])); // bottom-right
-    target_plane_vertices.push_back(cv::Point2f(ctrl_point_params[3][0], ctrl_point_params[3][1])); // bottom-left
-
-    // Use OpenCV's findHomography function to compute the homography matrix.
-    // This matrix will map the coordinates of the image (origin/source) plane the control point (target/destination) plane.
-    r_hom_mat = findHomography(origin_plane_vertices, target_plane_vertices);
+    float target_plane_xy[8] = {
+        ctrl_point_params[0][0], ctrl_point_params[0][1],  // top-left
+        ctrl_point_params[1][0], ctrl_point_params[1][1],  // top-right
+        ctrl_point_params[2][0], ctrl_point_params[2][1],  // bottom-right
+        ctrl_point_params[3][0], ctrl_point_params[3][1]}; // bottom-left
+
+    // Solve the exact 4 point homography mapping the image (origin/source) plane to the control point (target/destination) plane
+    Homography hom;
+    if (solveHomography4Point(origin_plane_xy, target_plane_xy, hom) != 0)
+    {
+        ROS_WARN_THROTTLE(1.0, "[HOMOGRAPHY] Degenerate Control Points, Keeping Previous Homography: TL[%0.3f,%0.3f] TR[%0.3f,%0.3f] BR[%0.3f,%0.3f] BL[%0.3f,%0.3f]",
+                  target_plane_xy[0], target_plane_xy[1], target_plane_xy[2], target_plane_xy[3],
+                  target_plane_xy[4], target_plane_xy[5], target_plane_xy[6], target_plane_xy[7]);
+        return -1;
+    }
+
+    // Store as CV_32F, the type read by saveCoordinatesXML() and the display node
+    homographyToMat(hom, r_hom_mat);
+    return 0;
 }
 
 std::vector<cv::Point2f> computePerspectiveWarp(std::vector<cv::Point2f> quad_vertices_vec, cv::Mat &r_hom_mat)
 {
-    // Iterate through each vertex in the quadrilateral
-    for (auto &vert : quad_vertices_vec)
+    // Copy the homography once instead of converting it for every vertex
+    Homography hom;
+    if (homographyFromMat(r_hom_mat, hom) != 0)
     {
-        // Convert to 3x1 homogeneous coordinate matrix
-        float data[] = {vert.x, vert.y, 1}; // Column matrix with the vertex's homogeneous coordinates [x, y, 1].
-        cv::Mat ptMat(3, 1, CV_32F, data);  // Point's homogeneous coordinates stored as a 3x1 matrix of type CV_32F (32-bit float)
+        ROS_ERROR("[WARP] Homography Matrix is Not 3x3 CV_32F or CV_64F: Size[%d,%d] Type[%d]", r_hom_mat.rows, r_hom_mat.cols, r_hom_mat.type());
+        return quad_vertices_vec;
+    }
 
-        // Homography Matrix Type Conversion (for later matrix multiplication)
-        r_hom_mat.convertTo(r_hom_mat, ptMat.type());
+    // cv::Point2f is two packed floats, so the vertices are warped in place as one batch
+    float *p_xy = reinterpret_cast<float *>(quad_vertices_vec.data());
+    transformPoints(hom, p_xy, p_xy, quad_vertices_vec.size());
 
-        // Apply Homography Matrix to Warp Perspective
-        // Multiply the homography matrix with the point's homogeneous coordinates.
-        // This results in a new column matrix representing the point's warped coordinates.
-        ptMat = r_hom_mat * ptMat;
+    return quad_vertices_vec;
+}
 
-        // Convert back to Cartesian Coordinates
-        ptMat /= ptMat.at<float>(2); // Divide first two elements by the third element (w)
+void computeWallVertices(const WallParamField &param_field, const cv::Mat &hom_mat, std::vector<float> &r_vertex_vec)
+{
+    Homography hom;
+    if (homographyFromMat(hom_mat, hom) != 0)
+    {
+        ROS_ERROR("[WARP] Homography Matrix is Not 3x3 CV_32F or CV_64F: Size[%d,%d] Type[%d]", hom_mat.rows, hom_mat.cols, hom_mat.type());
+        return;
+    }
 
-        // Update/overwrite original certex coordinates with the warped coordinates
-        vert.x = ptMat.at<float>(0, 0);
-        vert.y = ptMat.at<float>(0, 1);
+    // Grow the vector once for all the walls in the grid
+    const int grid_size = param_field.grid_size;
+    const int n_cells = grid_size * grid_size;
+    size_t vertex_start_i = r_vertex_vec.size();
+    r_vertex_vec.resize(vertex_start_i + n_cells * WALL_GEOMETRY_SIZE);
+    float *p_xy = r_vertex_vec.data() + vertex_start_i;
+
+    // Iterate through the maze grid
+    for (int grid_row_i = 0; grid_row_i < grid_size; grid_row_i++)
+    {
+        // Iterate through each cell in the maze row
+        for (int grid_col_i = 0; grid_col_i < grid_size; grid_col_i++)
+        {
+            int cell_i = grid_row_i * grid_size + grid_col_i;
+
+            // Get origin coordinates of wall
+            float x_origin = grid_col_i * param_field.wall_space_x;
+            float y_origin = grid_row_i * param_field.wall_space_y;
+
+            // Write the unwarped wall vertices straight into the output
+            computeQuadVertices(x_origin, y_origin, param_field.width_vec[cell_i], param_field.height_vec[cell_i],
+                                param_field.shear_x_vec[cell_i], param_field.shear_y_vec[cell_i], p_xy);
+            p_xy += WALL_GEOMETRY_SIZE;
+        }
     }
 
-    return quad_vertices_vec;
+    // Apply perspective warping to the vertices of all walls in one pass
+    float *p_xy_start = r_vertex_vec.data() + vertex_start_i;
+    transformPoints(hom, p_xy_start, p_xy_start, n_cells * 4);
 }
 
-void updateCalParams(std::array<std::array<float, 6>, 4> &r_ctrl_point_params, int mode_cal_ind)
+void updateCalParams(std::array<std::array<float, 6>, 4> &r_ctrl_point_params, int mode_cal_ind, int grid_size)
 {
     // Copy the default array to the dynamic one
     for (int i = 0; i < 4; ++i)
@@ -606,8 +981,17 @@ void updateCalParams(std::array<std::array<float, 6>, 4> &r_ctrl_point_params, i
         }
     }
 
+    // Scale the default wall size to the wall spacing of the maze
+    float wall_scale_x = (originPlaneWidth / (float(grid_size) - 1)) / WALL_SPACE_X;
+    float wall_scale_y = (originPlaneHeight / (float(grid_size) - 1)) / WALL_SPACE_Y;
+    for (int i = 0; i < 4; ++i)
+    {
+        r_ctrl_point_params[i][2] *= wall_scale_x;
+        r_ctrl_point_params[i][3] *= wall_scale_y;
+    }
+
     // Add an offset when calibrating left or right wall images
-    float horz_offset = 0.05f;
+    float horz_offset = 0.05f * wall_scale_x;
     if (mode_cal_ind == 0) // left wall
     {
         r_ctrl_point_params[0][0] -= horz_offset; // top-left
@@ -624,6 +1008,36 @@ void updateCalParams(std::array<std::array<float, 6>, 4> &r_ctrl_point_params, i
     }
 }
 
+int checkMazeSize(int grid_size)
+{
+    if (grid_size < MIN_MAZE_SIZE || grid_size > MAX_MAZE_SIZE)
+    {
+        ROS_ERROR("[MAZE] Unsupported Maze Size[%d] Range[%d,%d]", grid_size, MIN_MAZE_SIZE, MAX_MAZE_SIZE);
+        return -1;
+    }
+    return 0;
+}
+
+int getImgProjMapInd(int proj_i, int wall_row_i, int wall_col_i, int cal_i, int grid_size)
+{
+    return ((proj_i * grid_size + wall_row_i) * grid_size + wall_col_i) * N_CAL_MODES + cal_i;
+}
+
+void initImgProjMap(int grid_size, std::vector<int> &r_img_proj_map_vec)
+{
+    r_img_proj_map_vec.assign(N_IMG_PROJ_MAP_PROJ * grid_size * grid_size * N_CAL_MODES, 0);
+    if (grid_size != MAZE_SIZE)
+        return;
+
+    // Copy the hardcoded defaults
+    for (int proj_i = 0; proj_i < N_IMG_PROJ_MAP_PROJ; proj_i++)
+        for (int wall_row_i = 0; wall_row_i < grid_size; wall_row_i++)
+            for (int wall_col_i = 0; wall_col_i < grid_size; wall_col_i++)
+                for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+                    r_img_proj_map_vec[getImgProjMapInd(proj_i, wall_row_i, wall_col_i, cal_i, grid_size)] =
+                        IMG_PROJ_MAP[proj_i][wall_row_i][wall_col_i][cal_i];
+}
+
 void dbLogCtrlPointParams(std::array<std::array<float, 6>, 4> ctrl_point_params)
 {
     ROS_INFO("Control Point Parameters");
@@ -643,26 +1057,40 @@ void dbLogCtrlPointParams(std::array<std::array<float, 6>, 4> ctrl_point_params)
     ROS_INFO("---------------------------------------------------------");
 }
 
-void dbStoreQuadParams(float grid_row_i, float grid_col_i,
+void dbStoreQuadParams(int grid_size, float grid_row_i, float grid_col_i,
                        float quad_width, float quad_height,
                        float quad_shear_x, float quad_shear_y,
                        float quad_origin_x, float quad_origin_y,
                        const std::vector<cv::Point2f> &quad_vertices_raw,
                        const std::vector<cv::Point2f> &quad_vertices_warped)
 {
-    // Cast float indices to int
-    int row = static_cast<int>(grid_row_i);
-    int col = static_cast<int>(grid_col_i);
+    // Resize the storage if the maze size changed
+    if (dbParams.grid_size != grid_size)
+    {
+        int n_cells = grid_size * grid_size;
+        dbParams.grid_size = grid_size;
+        dbParams.quad_width.assign(n_cells, 0.0f);
+        dbParams.quad_height.assign(n_cells, 0.0f);
+        dbParams.quad_shear_x.assign(n_cells, 0.0f);
+        dbParams.quad_shear_y.assign(n_cells, 0.0f);
+        dbParams.quad_origin_x.assign(n_cells, 0.0f);
+        dbParams.quad_origin_y.assign(n_cells, 0.0f);
+        dbParams.quad_vertices_raw.assign(n_cells, std::vector<cv::Point2f>());
+        dbParams.quad_vertices_warped.assign(n_cells, std::vector<cv::Point2f>());
+    }
+
+    // Cast float indices to a flat cell index
+    int cell_i = static_cast<int>(grid_row_i) * grid_size + static_cast<int>(grid_col_i);
 
     // Store the parameters in the DebugParams struct
-    dbParams.quad_width[row][col] = quad_width;
-    dbParams.quad_height[row][col] = quad_height;
-    dbParams.quad_shear_x[row][col] = quad_shear_x;
-    dbParams.quad_shear_y[row][col] = quad_shear_y;
-    dbParams.quad_origin_x[row][col] = quad_origin_x;
-    dbParams.quad_origin_y[row][col] = quad_origin_y;
-    dbParams.quad_vertices_raw[row][col] = quad_vertices_raw;
-    dbParams.quad_vertices_warped[row][col] = quad_vertices_warped;
+    dbParams.quad_width[cell_i] = quad_width;
+    dbParams.quad_height[cell_i] = quad_height;
+    dbParams.quad_shear_x[cell_i] = quad_shear_x;
+    dbParams.quad_shear_y[cell_i] = quad_shear_y;
+    dbParams.quad_origin_x[cell_i] = quad_origin_x;
+    dbParams.quad_origin_y[cell_i] = quad_origin_y;
+    dbParams.quad_vertices_raw[cell_i] = quad_vertices_raw;
+    dbParams.quad_vertices_warped[cell_i] = quad_vertices_warped;
 }
 
 void dbLogQuadParams(std::string param_str)
@@ -676,18 +1104,19 @@ void dbLogQuadParams(std::string param_str)
         ROS_INFO("-----------------------------------------------------------------------------");
 
         // Loop through each row and column in the maze
-        for (int row = 0; row < MAZE_SIZE; ++row)
+        for (int row = 0; row < dbParams.grid_size; ++row)
         {
-            for (int col = 0; col < MAZE_SIZE; ++col)
+            for (int col = 0; col < dbParams.grid_size; ++col)
             {
+                int cell_i = row * dbParams.grid_size + col;
                 ROS_INFO(" [%d, %d]  |  %4.2f  |  %4.2f  |  %4.2f  |  %4.2f  |  %4.2f  |  %4.2f  |",
                          row, col,
-                         dbParams.quad_origin_x[row][col],
-                         dbParams.quad_origin_y[row][col],
-                         dbParams.quad_width[row][col],
-                         dbParams.quad_height[row][col],
-                         dbParams.quad_shear_x[row][col],
-                         dbParams.quad_shear_y[row][col]);
+                         dbParams.quad_origin_x[cell_i],
+                         dbParams.quad_origin_y[cell_i],
+                         dbParams.quad_width[cell_i],
+                         dbParams.quad_height[cell_i],
+                         dbParams.quad_shear_x[cell_i],
+                         dbParams.quad_shear_y[cell_i]);
             }
         }
 
@@ -701,12 +1130,14 @@ void dbLogQuadParams(std::string param_str)
         ROS_INFO("---------------------------------------------------------------------------------------");
 
         // Loop through each row and column in the maze
-        for (int row = 0; row < MAZE_SIZE; ++row)
+        for (int row = 0; row < dbParams.grid_size; ++row)
         {
-            for (int col = 0; col < MAZE_SIZE; ++col)
+            for (int col = 0; col < dbParams.grid_size; ++col)
             {
-                // Fetch the quad vertices for the current [row][col]
-                std::vector<cv::Point2f> quad = dbParams.quad_vertices_warped[row][col];
+                int cell_i = row * dbParams.grid_size + col;
+
+                // Fetch the quad vertices for the current cell
+                std::vector<cv::Point2f> quad = dbParams.quad_vertices_warped[cell_i];
 
                 // Ensure there are 4 vertices in the vector
                 if (quad.size() == 4)
@@ -0,0 +1,111 @@
+// ##########################################################################################################
+
+// ========================================= projection_watch.cpp =========================================
+
+// ##########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include "projection_watch.h"
+
+#include <sys/stat.h>
+
+// Directory change notification is platform specific
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// ================================================== FUNCTIONS ==================================================
+
+int openDirWatcher(const std::string &dir_path, DirWatcher &r_watcher)
+{
+    closeDirWatcher(r_watcher);
+#ifdef _WIN32
+    HANDLE handle = FindFirstChangeNotificationA(dir_path.c_str(), FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        ROS_ERROR("[WATCH] Could Not Watch Directory: Directory[%s]", dir_path.c_str());
+        return -1;
+    }
+    r_watcher.p_handle = handle;
+#else
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, dir_path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE) < 0)
+    {
+        ROS_ERROR("[WATCH] Could Not Watch Directory: Directory[%s]", dir_path.c_str());
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    r_watcher.fd = fd;
+#endif
+    r_watcher.dir_path = dir_path;
+    return 0;
+}
+
+int waitDirWatcher(DirWatcher &r_watcher, int timeout_ms)
+{
+#ifdef _WIN32
+    // The handle only says something changed, the caller works out what
+    DWORD status = WaitForSingleObject((HANDLE)r_watcher.p_handle, (DWORD)timeout_ms);
+    if (status == WAIT_TIMEOUT)
+        return 0;
+    if (status != WAIT_OBJECT_0 || !FindNextChangeNotification((HANDLE)r_watcher.p_handle))
+        return -1;
+    return 1;
+#else
+    struct pollfd poll_fd = {r_watcher.fd, POLLIN, 0};
+    int n_ready = poll(&poll_fd, 1, timeout_ms);
+    if (n_ready <= 0)
+        return n_ready == 0 ? 0 : -1;
+
+    // Drain the queued events, skipping the temporary files of atomic writes
+    bool is_changed = false;
+    alignas(struct inotify_event) char event_buf[4096];
+    ssize_t n_read;
+    while ((n_read = read(r_watcher.fd, event_buf, sizeof(event_buf))) > 0)
+    {
+        for (char *p_event = event_buf; p_event < event_buf + n_read;)
+        {
+            const struct inotify_event *p_inotify = reinterpret_cast<const struct inotify_event *>(p_event);
+            std::string name_str = p_inotify->len > 0 ? p_inotify->name : "";
+            bool is_tmp = name_str.size() >= 4 && name_str.compare(name_str.size() - 4, 4, ".tmp") == 0;
+            if (!is_tmp)
+                is_changed = true;
+            p_event += sizeof(struct inotify_event) + p_inotify->len;
+        }
+    }
+    return is_changed ? 1 : 0;
+#endif
+}
+
+void closeDirWatcher(DirWatcher &r_watcher)
+{
+#ifdef _WIN32
+    if (r_watcher.p_handle)
+        FindCloseChangeNotification((HANDLE)r_watcher.p_handle);
+#else
+    if (r_watcher.fd >= 0)
+        close(r_watcher.fd);
+#endif
+    r_watcher = DirWatcher();
+}
+
+int getFileModTime(const std::string &file_path, long long &r_mod_time)
+{
+    struct stat file_stat;
+    if (stat(file_path.c_str(), &file_stat) != 0)
+        return -1;
+    r_mod_time = (long long)file_stat.st_mtime;
+    return 0;
+}
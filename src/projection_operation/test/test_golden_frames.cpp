@@ -0,0 +1,47 @@
+// ########################################################################################################
+
+// ======================================== test_golden_frames.cpp ========================================
+
+// ########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include <gtest/gtest.h>
+#include <ros/package.h>
+
+#include <cstdlib>
+#include <string>
+
+// ================================================== VARIABLES ==================================================
+
+// Reference images rendered with the calibration in test/proj_cfg and the runtime_images walls,
+// regenerate with "_golden_update:=true" after an intended rendering change
+const std::string GOLDEN_DIR_PATH = ros::package::getPath("projection_operation") + "/test/golden";
+
+// Frozen copy of the calibration XML files, so recalibrating the rig does not change the rendered frames
+const std::string GOLDEN_CONFIG_DIR_PATH = ros::package::getPath("projection_operation") + "/test/proj_cfg";
+
+// The references come from llvmpipe, so allow for rasterization differences of other drivers along the wall edges
+const int GOLDEN_TOLERANCE = 8;
+const int GOLDEN_MAX_BAD_PXL = 2000;
+
+// ================================================== TESTS ==================================================
+
+TEST(GoldenFrames, HeadlessFramesMatchReferences)
+{
+    // compareGoldenFrames() makes the node exit non-zero on a mismatch and saves a heatmap next to the reference
+    std::string cmd_str = std::string("\"") + DISPLAY_NODE_PATH + "\"" +
+                          " _headless:=true _hot_reload:=false _live_calibration:=false" +
+                          " _config_dir:=\"" + GOLDEN_CONFIG_DIR_PATH + "\"" +
+                          " _golden_dir:=\"" + GOLDEN_DIR_PATH + "\"" +
+                          " _golden_tolerance:=" + std::to_string(GOLDEN_TOLERANCE) +
+                          " _golden_max_bad_pixels:=" + std::to_string(GOLDEN_MAX_BAD_PXL);
+    int status = std::system(cmd_str.c_str());
+    EXPECT_EQ(status, 0) << "Headless frames differ from the references in " << GOLDEN_DIR_PATH << ", see proj_<i>_diff.png";
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,193 @@
+// ########################################################################################################
+
+// ======================================== test_projection_utils.cpp ========================================
+
+// ########################################################################################################
+
+// ================================================== INCLUDE ==================================================
+
+#include <gtest/gtest.h>
+
+#include "projection_utils.h"
+
+// ================================================== VARIABLES ==================================================
+
+// Random control point perturbations per calibration mode in the homography solver test, and
+// how many of them may be rejected as non-convex before the test fails
+const int TEST_HOM_N_RAND = 100;
+const int TEST_HOM_MAX_REJECT = 5;
+
+// ================================================== FUNCTIONS ==================================================
+
+/**
+ * @brief Fills a base and an overlay buffer with seeded pseudo-random pixels.
+ *
+ * About 60% of the overlay pixels are set to white, like the UI masks, and every third one to the
+ * key color, so the color key kernels see a mix of kept and replaced pixels for every key.
+ */
+static void fillTestBuffers(std::vector<uint8_t> &r_base_vec, std::vector<uint8_t> &r_overlay_vec, size_t n_pxl,
+                            PixelFormat format, const std::array<uint8_t, 3> &key_rgb)
+{
+    int pxl_size = getPixelSize(format);
+    r_base_vec.resize(n_pxl * pxl_size);
+    r_overlay_vec.resize(n_pxl * pxl_size);
+
+    uint32_t rand_state = 12345;
+    for (size_t pxl_i = 0; pxl_i < n_pxl; pxl_i++)
+    {
+        rand_state = rand_state * 1664525u + 1013904223u;
+        bool is_white = (rand_state >> 28) < 10;
+        for (int ch_i = 0; ch_i < pxl_size; ch_i++)
+        {
+            rand_state = rand_state * 1664525u + 1013904223u;
+            r_base_vec[pxl_i * pxl_size + ch_i] = (uint8_t)(rand_state >> 24);
+            rand_state = rand_state * 1664525u + 1013904223u;
+            r_overlay_vec[pxl_i * pxl_size + ch_i] = is_white && ch_i < 3 ? 255 : (uint8_t)(rand_state >> 24);
+        }
+        if (pxl_i % 3 == 0)
+            for (int ch_i = 0; ch_i < 3; ch_i++)
+                r_overlay_vec[pxl_i * pxl_size + ch_i] = key_rgb[format == PIXEL_BGR ? 2 - ch_i : ch_i];
+    }
+}
+
+/**
+ * @brief Solves one target quad from the origin plane corners.
+ *
+ * @return 0 if the corners land on the target, 1 if the solver rejected it, -1 on a mismatch.
+ */
+static int solveAndCheck(const float *origin_plane_xy, const std::array<float, 8> &target_xy)
+{
+    Homography hom;
+    if (solveHomography4Point(origin_plane_xy, target_xy.data(), hom) != 0)
+        return 1;
+
+    float warped_xy[8];
+    transformPoints(hom, origin_plane_xy, warped_xy, 4);
+    for (int i = 0; i < 8; i++)
+    {
+        if (std::fabs(warped_xy[i] - target_xy[i]) > 1e-4f)
+        {
+            ADD_FAILURE() << "Coordinate[" << i << "] Warped[" << warped_xy[i] << "] Target[" << target_xy[i] << "]";
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Gets the default control point positions of a calibration mode as a target quad.
+ */
+static std::array<float, 8> getDefaultTarget(int cal_ind)
+{
+    std::array<std::array<float, 6>, 4> ctrl_point_params;
+    updateCalParams(ctrl_point_params, cal_ind, MAZE_SIZE);
+    std::array<float, 8> target_xy;
+    for (int cp_i = 0; cp_i < 4; cp_i++)
+    {
+        target_xy[cp_i * 2] = ctrl_point_params[cp_i][0];
+        target_xy[cp_i * 2 + 1] = ctrl_point_params[cp_i][1];
+    }
+    return target_xy;
+}
+
+// ================================================== TESTS ==================================================
+
+TEST(CompositeKernels, MatchScalarKernel)
+{
+    const PixelFormat format_arr[] = {PIXEL_RGB, PIXEL_BGR, PIXEL_RGBA};
+    const std::array<uint8_t, 3> key_arr[] = {COMPOSITE_KEY_WHITE, {{0, 0, 0}}, {{12, 200, 77}}};
+
+    // Sizes around the vector widths so the scalar tails are covered
+    const size_t n_pxl_arr[] = {0, 1, 4, 5, 7, 8, 9, 10, 11, 15, 16, 17, 31, 33, 100, WALL_WIDTH_PXL * WALL_HEIGHT_PXL};
+
+    for (int kernel_i = KERNEL_SSE2; kernel_i < N_COMPOSITE_KERNELS; kernel_i++)
+    {
+        CompositeKernel kernel = (CompositeKernel)kernel_i;
+        if (!isCompositeKernelSupported(kernel))
+            continue;
+
+        for (PixelFormat format : format_arr)
+            for (int mode_i = COMPOSITE_COLOR_KEY; mode_i <= COMPOSITE_ALPHA; mode_i++)
+            {
+                CompositeMode mode = (CompositeMode)mode_i;
+                if (mode == COMPOSITE_ALPHA && format != PIXEL_RGBA)
+                    continue;
+
+                for (const std::array<uint8_t, 3> &key_rgb : key_arr)
+                    for (size_t n_pxl : n_pxl_arr)
+                    {
+                        SCOPED_TRACE(std::string("Kernel[") + getCompositeKernelName(kernel) + "] Format[" + std::to_string(format) +
+                                     "] Mode[" + std::to_string(mode) + "] Pixels[" + std::to_string(n_pxl) + "]");
+
+                        std::vector<uint8_t> base_vec, overlay_vec;
+                        fillTestBuffers(base_vec, overlay_vec, n_pxl, format, key_rgb);
+
+                        // Reference, separate output, and both in-place variants must be byte exact
+                        std::vector<uint8_t> ref_vec(base_vec.size()), out_vec(base_vec.size());
+                        std::vector<uint8_t> base_inplace_vec = base_vec, overlay_inplace_vec = overlay_vec;
+                        ASSERT_EQ(compositeImagesWith(KERNEL_SCALAR, base_vec.data(), overlay_vec.data(), ref_vec.data(), n_pxl, format, mode, key_rgb), 0);
+                        ASSERT_EQ(compositeImagesWith(kernel, base_vec.data(), overlay_vec.data(), out_vec.data(), n_pxl, format, mode, key_rgb), 0);
+                        ASSERT_EQ(compositeImagesWith(kernel, base_inplace_vec.data(), overlay_vec.data(), base_inplace_vec.data(), n_pxl, format, mode, key_rgb), 0);
+                        ASSERT_EQ(compositeImagesWith(kernel, base_vec.data(), overlay_inplace_vec.data(), overlay_inplace_vec.data(), n_pxl, format, mode, key_rgb), 0);
+                        EXPECT_EQ(out_vec, ref_vec);
+                        EXPECT_EQ(base_inplace_vec, ref_vec);
+                        EXPECT_EQ(overlay_inplace_vec, ref_vec);
+                    }
+            }
+    }
+}
+
+TEST(HomographySolver, SolvesDefaultControlPoints)
+{
+    float origin_plane_xy[8];
+    computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f, origin_plane_xy);
+
+    // The defaults are what every new calibration starts from so they must always solve
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+        EXPECT_EQ(solveAndCheck(origin_plane_xy, getDefaultTarget(cal_i)), 0) << "Mode[" << cal_i << "]";
+}
+
+TEST(HomographySolver, SolvesPerturbedControlPoints)
+{
+    float origin_plane_xy[8];
+    computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f, origin_plane_xy);
+
+    // Perturbations can make the quad non-convex, which the solver is allowed to reject
+    for (int cal_i = 0; cal_i < N_CAL_MODES; cal_i++)
+    {
+        std::array<float, 8> target_xy = getDefaultTarget(cal_i);
+        int n_reject = 0;
+        uint32_t rand_state = 777 + cal_i;
+        for (int rep_i = 0; rep_i < TEST_HOM_N_RAND; rep_i++)
+        {
+            std::array<float, 8> target_rand_xy = target_xy;
+            for (float &val : target_rand_xy)
+            {
+                rand_state = rand_state * 1664525u + 1013904223u;
+                val += ((float)(rand_state >> 8) / (float)(1 << 24) - 0.5f) * 0.1f;
+            }
+            int status = solveAndCheck(origin_plane_xy, target_rand_xy);
+            EXPECT_NE(status, -1) << "Mode[" << cal_i << "] Perturbation[" << rep_i << "]";
+            if (status == 1)
+                n_reject++;
+        }
+        EXPECT_LE(n_reject, TEST_HOM_MAX_REJECT) << "Mode[" << cal_i << "] Rejected[" << n_reject << "/" << TEST_HOM_N_RAND << "]";
+    }
+}
+
+TEST(HomographySolver, RejectsCollinearControlPoints)
+{
+    float origin_plane_xy[8];
+    computeQuadVertices(0.0f, 0.0f, originPlaneWidth, originPlaneHeight, 0.0f, 0.0f, origin_plane_xy);
+
+    // Three collinear points must be rejected
+    const float collinear_xy[8] = {-0.5f, 0.5f, 0.0f, 0.5f, 0.5f, 0.5f, 0.0f, -0.5f};
+    Homography hom_degenerate;
+    EXPECT_NE(solveHomography4Point(origin_plane_xy, collinear_xy, hom_degenerate), 0);
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}